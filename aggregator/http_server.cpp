@@ -0,0 +1,259 @@
+/**
+ * @file http_server.cpp
+ * @brief Keep-alive HTTP/1.1 server implementation.
+ */
+
+#include "http_server.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace agg {
+
+/// Requests larger than this are rejected; a 64-symbol query is ~400 bytes.
+static const size_t MAX_REQUEST_SIZE = 4096;
+
+static bool set_nonblocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/// Split "BTC,ETH" into symbols; false if any is malformed or too many.
+static bool parse_symbols(const std::string& list, std::vector<std::string>& symbols) {
+  std::stringstream stream(list);
+  std::string       symbol;
+  while (std::getline(stream, symbol, ',')) {
+    if (!valid_symbol(symbol)) return false;
+    symbols.push_back(symbol);
+  }
+  return !symbols.empty() && symbols.size() <= MAX_SYMBOLS;
+}
+
+HttpServer::HttpServer(PriceTable& table, uint16_t port) : table_(table), port_(port) {}
+
+HttpServer::~HttpServer() {
+  for (auto& [fd, client] : clients_) close(fd);
+  if (listen_fd_ >= 0) close(listen_fd_);
+  if (epoll_fd_ >= 0) close(epoll_fd_);
+}
+
+bool HttpServer::listen() {
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    perror("[http] socket");
+    return false;
+  }
+  int one = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr{};
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port        = htons(port_);
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      ::listen(listen_fd_, SOMAXCONN) < 0) {
+    perror("[http] bind/listen");
+    return false;
+  }
+  set_nonblocking(listen_fd_);
+
+  epoll_fd_ = epoll_create1(0);
+  epoll_event ev{};
+  ev.events  = EPOLLIN;
+  ev.data.fd = listen_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev);
+  return true;
+}
+
+void HttpServer::run(const std::atomic<bool>& stop) {
+  epoll_event events[256];
+  while (!stop) {
+    int n = epoll_wait(epoll_fd_, events, 256, 200);
+    if (n < 0 && errno != EINTR) {
+      perror("[http] epoll_wait");
+      return;
+    }
+    for (int i = 0; i < n; i++) {
+      int fd = events[i].data.fd;
+      if (fd == listen_fd_) {
+        accept_all();
+        continue;
+      }
+      auto it = clients_.find(fd);
+      if (it == clients_.end()) continue;
+
+      if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+        drop(fd);
+        continue;
+      }
+      if ((events[i].events & EPOLLOUT) && !on_writable(fd, it->second)) continue;
+      if (events[i].events & EPOLLIN) on_readable(fd, it->second);
+    }
+  }
+}
+
+void HttpServer::accept_all() {
+  for (;;) {
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) return;                                // EAGAIN: backlog drained
+    set_nonblocking(fd);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    epoll_event ev{};
+    ev.events  = EPOLLIN;
+    ev.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    clients_[fd];
+  }
+}
+
+void HttpServer::on_readable(int fd, Client& client) {
+  char buf[4096];
+  for (;;) {
+    ssize_t n = read(fd, buf, sizeof(buf));
+    if (n > 0) {
+      client.in.append(buf, n);
+      continue;
+    }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+      drop(fd);
+      return;
+    }
+    break;
+  }
+
+  // Requests carry no body, so each one ends at the blank line.  Several
+  // may arrive at once from a pipelining client.
+  size_t end;
+  while ((end = client.in.find("\r\n\r\n")) != std::string::npos) {
+    handle_request(client.in.substr(0, end), client);
+    client.in.erase(0, end + 4);
+  }
+  if (client.in.size() > MAX_REQUEST_SIZE) {
+    client.close_after = true;
+    respond(client, 431, "Request Header Fields Too Large", "text/plain", "too large\n");
+    client.in.clear();
+  }
+  on_writable(fd, client);
+}
+
+bool HttpServer::on_writable(int fd, Client& client) {
+  while (!client.out.empty()) {
+    ssize_t n = write(fd, client.out.data(), client.out.size());
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        watch_output(fd, true);
+        return true;
+      }
+      drop(fd);
+      return false;
+    }
+    client.out.erase(0, n);
+  }
+  watch_output(fd, false);
+  if (client.close_after) {
+    drop(fd);
+    return false;
+  }
+  return true;
+}
+
+void HttpServer::handle_request(const std::string& head, Client& client) {
+  // "GET /v1/prices?symbols=BTC,ETH HTTP/1.1"
+  size_t line_end = head.find("\r\n");
+  std::string line = head.substr(0, line_end);
+  size_t sp1 = line.find(' ');
+  size_t sp2 = line.rfind(' ');
+  if (sp1 == std::string::npos || sp2 <= sp1) {
+    client.close_after = true;
+    respond(client, 400, "Bad Request", "text/plain", "bad request\n");
+    return;
+  }
+  std::string method  = line.substr(0, sp1);
+  std::string target  = line.substr(sp1 + 1, sp2 - sp1 - 1);
+  std::string version = line.substr(sp2 + 1);
+
+  // HTTP/1.0 closes by default; either version honours "Connection: close".
+  bool close = (version == "HTTP/1.0");
+  for (size_t pos = line_end; pos != std::string::npos && pos < head.size();) {
+    size_t next = head.find("\r\n", pos + 2);
+    std::string header = head.substr(pos + 2, next == std::string::npos ? std::string::npos
+                                                                       : next - pos - 2);
+    if (strncasecmp(header.c_str(), "Connection:", 11) == 0) {
+      std::string value = header.substr(11);
+      if (strcasestr(value.c_str(), "close"))      close = true;
+      if (strcasestr(value.c_str(), "keep-alive")) close = false;
+    }
+    pos = next;
+  }
+  client.close_after = client.close_after || close;
+
+  if (method != "GET") {
+    respond(client, 405, "Method Not Allowed", "text/plain", "GET only\n");
+    return;
+  }
+
+  static const std::string PRICES = "/v1/prices?symbols=";
+  if (target.compare(0, PRICES.size(), PRICES) == 0) {
+    std::vector<std::string> symbols;
+    if (!parse_symbols(target.substr(PRICES.size()), symbols)) {
+      respond(client, 400, "Bad Request", "text/plain", "bad symbols\n");
+      return;
+    }
+    uint32_t           epoch, seq;
+    std::vector<Quote> quotes = table_.lookup(symbols, &epoch, &seq);
+    std::string        frame;
+    encode_frame(frame, epoch, seq, quotes);
+    respond(client, 200, "OK", "application/octet-stream", frame);
+  } else if (target == "/healthz") {
+    respond(client, 200, "OK", "text/plain", "ok\n");
+  } else {
+    respond(client, 404, "Not Found", "text/plain", "not found\n");
+  }
+}
+
+void HttpServer::respond(Client& client, int status, const char* reason,
+                         const char* content_type, const std::string& body) {
+  char head[256];
+  int  len = snprintf(head, sizeof(head),
+                      "HTTP/1.1 %d %s\r\n"
+                      "Content-Type: %s\r\n"
+                      "Content-Length: %zu\r\n"
+                      "Connection: %s\r\n"
+                      "\r\n",
+                      status, reason, content_type, body.size(),
+                      client.close_after ? "close" : "keep-alive");
+  client.out.append(head, len);
+  client.out.append(body);
+}
+
+void HttpServer::drop(int fd) {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  clients_.erase(fd);
+}
+
+void HttpServer::watch_output(int fd, bool want) {
+  Client& client = clients_[fd];
+  if (client.watching_output == want) return;
+  client.watching_output = want;
+
+  epoll_event ev{};
+  ev.events  = want ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+  ev.data.fd = fd;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+}
+
+}  // namespace agg
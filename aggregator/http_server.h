@@ -0,0 +1,62 @@
+/**
+ * @file http_server.h
+ * @brief Minimal keep-alive HTTP/1.1 server for the tracker fleet.
+ *
+ * One thread, one epoll set, non-blocking sockets.  Requests are tiny and
+ * every response is built from an in-memory table, so a single thread
+ * serves hundreds of devices without ever blocking.
+ *
+ * Routes:
+ *  - @c GET /v1/prices?symbols=BTC,ETH → binary frame (protocol.h)
+ *  - @c GET /healthz                   → "ok"
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "price_table.h"
+
+namespace agg {
+
+class HttpServer {
+ public:
+  HttpServer(PriceTable& table, uint16_t port);
+  ~HttpServer();
+
+  HttpServer(const HttpServer&)            = delete;
+  HttpServer& operator=(const HttpServer&) = delete;
+
+  /// Bind and listen.  Returns false (with a message on stderr) on failure.
+  bool listen();
+
+  /// Serve until @p stop is set; checks it at least every 200 ms.
+  void run(const std::atomic<bool>& stop);
+
+ private:
+  struct Client {
+    std::string in;
+    std::string out;
+    bool        close_after     = false;
+    bool        watching_output = false;   ///< EPOLLOUT armed: output is backed up
+  };
+
+  void accept_all();
+  void on_readable(int fd, Client& client);
+  bool on_writable(int fd, Client& client);
+  void handle_request(const std::string& head, Client& client);
+  void respond(Client& client, int status, const char* reason,
+               const char* content_type, const std::string& body);
+  void drop(int fd);
+  void watch_output(int fd, bool want);
+
+  PriceTable&                     table_;
+  uint16_t                        port_;
+  int                             listen_fd_ = -1;
+  int                             epoll_fd_  = -1;
+  std::unordered_map<int, Client> clients_;
+};
+
+}  // namespace agg
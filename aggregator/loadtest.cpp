@@ -0,0 +1,189 @@
+/**
+ * @file loadtest.cpp
+ * @brief aggregator-loadtest: simulate a tracker fleet against the daemon.
+ *
+ * Opens one keep-alive connection per simulated tracker and has each one
+ * request its watchlist every interval, like the firmware does.  Every
+ * response is checked for a valid frame; latency is measured from write to
+ * complete response.
+ *
+ * Usage:
+ * @code
+ * aggregator-loadtest [--host 127.0.0.1] [--port 8080] [--clients 500]
+ *                     [--interval-ms 1000] [--seconds 10] [--symbols BTC,ETH]
+ * @endcode
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "protocol.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Sim {
+  int               fd = -1;
+  std::string       in;
+  Clock::time_point sent;
+  Clock::time_point next;
+  bool              waiting = false;
+};
+
+static size_t count_symbols(const std::string& list) {
+  return std::count(list.begin(), list.end(), ',') + 1;
+}
+
+/// Parse one complete response off the front of @p in.  Returns the number
+/// of bytes consumed, 0 if incomplete, or -1 if malformed.
+static long take_response(const std::string& in, size_t symbols) {
+  size_t end = in.find("\r\n\r\n");
+  if (end == std::string::npos) return 0;
+  if (in.compare(0, 12, "HTTP/1.1 200") != 0) return -1;
+
+  const char* cl = strcasestr(in.c_str(), "Content-Length:");
+  if (!cl || cl > in.c_str() + end) return -1;
+  size_t length = strtoul(cl + 15, nullptr, 10);
+  size_t total  = end + 4 + length;
+  if (in.size() < total) return 0;
+
+  const unsigned char* body = reinterpret_cast<const unsigned char*>(in.data()) + end + 4;
+  uint32_t magic = body[0] | (body[1] << 8) | (body[2] << 16) | (uint32_t(body[3]) << 24);
+  uint16_t count = body[4] | (body[5] << 8);
+  if (magic != agg::FRAME_MAGIC || count != symbols ||
+      length != agg::FRAME_HEADER_SIZE + agg::FRAME_RECORD_SIZE * count) {
+    return -1;
+  }
+  return static_cast<long>(total);
+}
+
+static int connect_to(const char* host, uint16_t port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port   = htons(port);
+  inet_pton(AF_INET, host, &addr.sin_addr);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  return fd;
+}
+
+int main(int argc, char** argv) {
+  const char* host        = "127.0.0.1";
+  uint16_t    port        = 8080;
+  int         clients     = 500;
+  long        interval_ms = 1000;
+  long        seconds     = 10;
+  std::string symbols     = "BTC,ETH";
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (strcmp(argv[i], "--host") == 0)        host        = argv[i + 1];
+    else if (strcmp(argv[i], "--port") == 0)        port        = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--clients") == 0)     clients     = atoi(argv[i + 1]);
+    else if (strcmp(argv[i], "--interval-ms") == 0) interval_ms = atol(argv[i + 1]);
+    else if (strcmp(argv[i], "--seconds") == 0)     seconds     = atol(argv[i + 1]);
+    else if (strcmp(argv[i], "--symbols") == 0)     symbols     = argv[i + 1];
+    else {
+      fprintf(stderr, "unknown option %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  const std::string request = "GET /v1/prices?symbols=" + symbols + " HTTP/1.1\r\n"
+                              "Host: aggregator\r\n\r\n";
+  const size_t      n_symbols = count_symbols(symbols);
+  const auto        interval  = std::chrono::milliseconds(interval_ms);
+
+  int              epfd = epoll_create1(0);
+  std::vector<Sim> sims(clients);
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < clients; i++) {
+    sims[i].fd = connect_to(host, port);
+    if (sims[i].fd < 0) {
+      fprintf(stderr, "connect %d failed: %s\n", i, strerror(errno));
+      return 1;
+    }
+    // Spread the fleet evenly over one interval, as real devices would be.
+    sims[i].next = start + interval * i / clients;
+    epoll_event ev{};
+    ev.events   = EPOLLIN;
+    ev.data.u32 = i;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, sims[i].fd, &ev);
+  }
+
+  std::vector<double> latencies_us;
+  long                errors   = 0;
+  Clock::time_point   deadline = start + std::chrono::seconds(seconds);
+
+  while (Clock::now() < deadline) {
+    Clock::time_point now = Clock::now();
+    for (Sim& sim : sims) {
+      if (sim.waiting || sim.fd < 0 || now < sim.next) continue;
+      if (write(sim.fd, request.data(), request.size()) != (ssize_t)request.size()) {
+        errors++;
+        continue;
+      }
+      sim.sent    = now;
+      sim.next   += interval;
+      sim.waiting = true;
+    }
+
+    epoll_event events[256];
+    int n = epoll_wait(epfd, events, 256, 1);
+    for (int e = 0; e < n; e++) {
+      Sim& sim = sims[events[e].data.u32];
+      char buf[4096];
+      ssize_t r;
+      while ((r = read(sim.fd, buf, sizeof(buf))) > 0) sim.in.append(buf, r);
+      if (r == 0) {
+        errors++;
+        epoll_ctl(epfd, EPOLL_CTL_DEL, sim.fd, nullptr);
+        close(sim.fd);
+        sim.fd = -1;
+        continue;
+      }
+      long used = take_response(sim.in, n_symbols);
+      if (used < 0) {
+        errors++;
+        sim.in.clear();
+        sim.waiting = false;
+      } else if (used > 0) {
+        latencies_us.push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - sim.sent).count());
+        sim.in.erase(0, used);
+        sim.waiting = false;
+      }
+    }
+  }
+
+  double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto pct = [&](double p) {
+    if (latencies_us.empty()) return 0.0;
+    return latencies_us[std::min(latencies_us.size() - 1,
+                                 static_cast<size_t>(p * latencies_us.size()))];
+  };
+  printf("clients %d, interval %ld ms, %zu responses in %.1f s (%.0f req/s), %ld errors\n",
+         clients, interval_ms, latencies_us.size(), elapsed, latencies_us.size() / elapsed, errors);
+  printf("latency us: p50 %.0f  p90 %.0f  p99 %.0f  max %.0f\n",
+         pct(0.50), pct(0.90), pct(0.99), latencies_us.empty() ? 0.0 : latencies_us.back());
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file main.cpp
+ * @brief tracker-aggregator: one upstream poller, many trackers.
+ *
+ * Usage:
+ * @code
+ * tracker-aggregator [--port 8080] [--poll-ms 1000] [--idle-expiry 300] [--offline]
+ * @endcode
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "http_server.h"
+#include "poller.h"
+#include "price_table.h"
+
+static std::atomic<bool> stop_requested{false};
+
+static void on_signal(int) {
+  stop_requested = true;
+}
+
+static void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [--port N] [--poll-ms N] [--idle-expiry SECONDS] [--offline]\n"
+          "  --port         listen port for trackers (default 8080)\n"
+          "  --poll-ms      upstream price poll period (default 1000)\n"
+          "  --idle-expiry  stop polling a symbol no tracker asked for in this long (default 300)\n"
+          "  --offline      serve random-walk prices instead of polling Binance\n",
+          argv0);
+}
+
+int main(int argc, char** argv) {
+  uint16_t           port        = 8080;
+  long               poll_ms     = 1000;
+  long               idle_expiry = 300;
+  agg::PollerOptions options;
+
+  for (int i = 1; i < argc; i++) {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--port") == 0 && has_value) {
+      port = static_cast<uint16_t>(atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--poll-ms") == 0 && has_value) {
+      poll_ms = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--idle-expiry") == 0 && has_value) {
+      idle_expiry = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--offline") == 0) {
+      options.offline = true;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (poll_ms < 100 || idle_expiry < 1) {
+    fprintf(stderr, "--poll-ms must be >= 100 and --idle-expiry >= 1\n");
+    return 2;
+  }
+  options.interval = std::chrono::milliseconds(poll_ms);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  signal(SIGPIPE, SIG_IGN);
+
+  agg::PriceTable table{std::chrono::seconds(idle_expiry)};
+  agg::HttpServer server(table, port);
+  if (!server.listen()) return 1;
+
+  fprintf(stderr, "[main] serving on :%u, polling every %ld ms%s\n", port, poll_ms,
+          options.offline ? " (offline)" : "");
+
+  std::thread poller([&] { agg::run_poller(table, options, stop_requested); });
+  server.run(stop_requested);
+  stop_requested = true;
+  poller.join();
+  return 0;
+}
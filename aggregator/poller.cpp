@@ -0,0 +1,155 @@
+/**
+ * @file poller.cpp
+ * @brief Upstream poll loop implementation.
+ */
+
+#include "poller.h"
+
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <thread>
+
+#include "upstream.h"
+
+namespace agg {
+
+static const char API_HOST[] = "api.binance.com";
+static const char QUOTE[]    = "USDT";
+
+/// tradingDay accepts at most 100 symbols per request.
+static const size_t TRADING_DAY_BATCH = 100;
+
+/// URL-encoded JSON array: %5B%22BTCUSDT%22,%22ETHUSDT%22%5D
+static std::string symbols_param(std::vector<std::string>::const_iterator first,
+                                 std::vector<std::string>::const_iterator last) {
+  std::string param = "%5B";
+  for (auto it = first; it != last; ++it) {
+    if (it != first) param += ",";
+    param += "%22" + *it + QUOTE + "%22";
+  }
+  return param + "%5D";
+}
+
+static uint32_t utc_now() {
+  return static_cast<uint32_t>(time(nullptr));
+}
+
+// ─── Online ────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Find and reject the symbols that made a batch fail.
+ *
+ * Binance answers 400 for the whole batch if any one symbol is not listed.
+ * Probing each one individually costs a few requests once; afterwards the
+ * bad symbol is no longer polled.
+ */
+static void reject_invalid(Upstream& upstream, PriceTable& table,
+                           const std::vector<std::string>& symbols) {
+  std::string body;
+  for (const std::string& symbol : symbols) {
+    int status = upstream.get("/api/v3/ticker/price?symbol=" + symbol + QUOTE, body);
+    if (status == 400) {
+      fprintf(stderr, "[poller] %s%s is not listed; ignoring it\n", symbol.c_str(), QUOTE);
+      table.reject(symbol);
+    }
+  }
+}
+
+static bool fetch_prices(Upstream& upstream, PriceTable& table,
+                         const std::vector<std::string>& symbols) {
+  std::string body;
+  int status = upstream.get("/api/v3/ticker/price?symbols=" +
+                            symbols_param(symbols.begin(), symbols.end()), body);
+  if (status == 400) {
+    reject_invalid(upstream, table, symbols);
+    return false;
+  }
+  if (status != 200) {
+    fprintf(stderr, "[poller] price request failed (%d)\n", status);
+    return false;
+  }
+  table.update_prices(parse_symbol_field(body, "price", QUOTE), utc_now());
+  return true;
+}
+
+static bool fetch_opens(Upstream& upstream, PriceTable& table,
+                        const std::vector<std::string>& symbols) {
+  for (size_t i = 0; i < symbols.size(); i += TRADING_DAY_BATCH) {
+    auto last = symbols.begin() + std::min(symbols.size(), i + TRADING_DAY_BATCH);
+    std::string body;
+    int status = upstream.get("/api/v3/ticker/tradingDay?type=MINI&symbols=" +
+                              symbols_param(symbols.begin() + i, last), body);
+    if (status != 200) {
+      fprintf(stderr, "[poller] open request failed (%d)\n", status);
+      return false;
+    }
+    table.update_opens(parse_symbol_field(body, "openPrice", QUOTE));
+  }
+  return true;
+}
+
+static void poll_online(PriceTable& table, const PollerOptions& options,
+                        const std::atomic<bool>& stop) {
+  Upstream upstream(API_HOST);
+
+  std::vector<std::string> opens_for;     // symbol set the opens were fetched for
+  uint32_t                 opens_day = 0;
+  auto                     opens_at  = std::chrono::steady_clock::time_point{};
+
+  while (!stop) {
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::string> symbols = table.wanted();
+
+    if (!symbols.empty() && fetch_prices(upstream, table, symbols)) {
+      uint32_t day = utc_now() / 86400;
+      if (symbols != opens_for || day != opens_day ||
+          started - opens_at >= options.opens_refresh) {
+        if (fetch_opens(upstream, table, symbols)) {
+          opens_for = symbols;
+          opens_day = day;
+          opens_at  = started;
+        }
+      }
+    }
+    std::this_thread::sleep_until(started + options.interval);
+  }
+}
+
+// ─── Offline ───────────────────────────────────────────────────────────────
+
+/// Random-walk prices for load tests without touching the exchange.
+static void poll_offline(PriceTable& table, const PollerOptions& options,
+                         const std::atomic<bool>& stop) {
+  std::mt19937_64                 rng(1);
+  std::normal_distribution<double> step(0.0, 0.0005);
+  std::map<std::string, int64_t>  prices;
+
+  while (!stop) {
+    auto started = std::chrono::steady_clock::now();
+    std::map<std::string, int64_t> opens;
+    for (const std::string& symbol : table.wanted()) {
+      auto it = prices.find(symbol);
+      if (it == prices.end()) {
+        int64_t start = 100 * PRICE_SCALE + static_cast<int64_t>(rng() % (1000 * PRICE_SCALE));
+        prices[symbol] = start;
+        opens[symbol]  = start;
+      } else {
+        it->second += static_cast<int64_t>(it->second * step(rng));
+      }
+    }
+    table.update_opens(opens);
+    table.update_prices(prices, utc_now());
+    std::this_thread::sleep_until(started + options.interval);
+  }
+}
+
+void run_poller(PriceTable& table, const PollerOptions& options, const std::atomic<bool>& stop) {
+  if (options.offline) {
+    poll_offline(table, options, stop);
+  } else {
+    poll_online(table, options, stop);
+  }
+}
+
+}  // namespace agg
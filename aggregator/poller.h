@@ -0,0 +1,30 @@
+/**
+ * @file poller.h
+ * @brief Upstream poll loop that keeps the PriceTable current.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "price_table.h"
+
+namespace agg {
+
+struct PollerOptions {
+  std::chrono::milliseconds interval{1000};       ///< price poll period
+  std::chrono::seconds      opens_refresh{60};    ///< open re-check period
+  bool                      offline = false;      ///< synthesise prices, no network
+};
+
+/**
+ * @brief Poll until @p stop is set.
+ *
+ * One batched @c ticker/price request per interval covers every symbol any
+ * device asked for, so exchange load is independent of fleet size.  Opens
+ * come from @c ticker/tradingDay when new symbols appear, at each UTC day
+ * change, and every @c opens_refresh otherwise.
+ */
+void run_poller(PriceTable& table, const PollerOptions& options, const std::atomic<bool>& stop);
+
+}  // namespace agg
@@ -0,0 +1,71 @@
+/**
+ * @file price_table.cpp
+ * @brief Shared quote table implementation.
+ */
+
+#include "price_table.h"
+
+namespace agg {
+
+std::vector<Quote> PriceTable::lookup(const std::vector<std::string>& symbols,
+                                      uint32_t* epoch, uint32_t* seq) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Clock::time_point now = Clock::now();
+
+  std::vector<Quote> quotes;
+  quotes.reserve(symbols.size());
+  for (const std::string& symbol : symbols) {
+    if (rejected_.count(symbol)) {
+      quotes.emplace_back();
+      continue;
+    }
+    Entry& entry      = entries_[symbol];   // first request adds it to the poll
+    entry.last_wanted = now;
+    quotes.push_back(entry.quote);
+  }
+  *epoch = epoch_;
+  *seq   = seq_;
+  return quotes;
+}
+
+std::vector<std::string> PriceTable::wanted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Clock::time_point now = Clock::now();
+
+  std::vector<std::string> symbols;
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (now - it->second.last_wanted > expiry_) {
+      it = entries_.erase(it);
+    } else {
+      symbols.push_back(it->first);
+      ++it;
+    }
+  }
+  return symbols;
+}
+
+void PriceTable::update_prices(const std::map<std::string, int64_t>& prices, uint32_t epoch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [symbol, price] : prices) {
+    auto it = entries_.find(symbol);
+    if (it != entries_.end()) it->second.quote.price = price;
+  }
+  epoch_ = epoch;
+  seq_++;
+}
+
+void PriceTable::update_opens(const std::map<std::string, int64_t>& opens) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [symbol, open] : opens) {
+    auto it = entries_.find(symbol);
+    if (it != entries_.end()) it->second.quote.open = open;
+  }
+}
+
+void PriceTable::reject(const std::string& symbol) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  rejected_.insert(symbol);
+  entries_.erase(symbol);
+}
+
+}  // namespace agg
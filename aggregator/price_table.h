@@ -0,0 +1,69 @@
+/**
+ * @file price_table.h
+ * @brief Latest quotes for the union of every device's watchlist.
+ *
+ * Requests from devices both read quotes and register interest: a symbol
+ * stays in the upstream poll for as long as some device asked for it within
+ * the expiry window.  The HTTP server thread and the upstream poller thread
+ * share one table under a mutex; every operation is a few map lookups.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "protocol.h"
+
+namespace agg {
+
+class PriceTable {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit PriceTable(std::chrono::seconds expiry) : expiry_(expiry) {}
+
+  /**
+   * @brief Quotes for @p symbols, in order; marks them as wanted.
+   * @param epoch  Receives the UTC time of the last price update.
+   * @param seq    Receives the update sequence number.
+   */
+  std::vector<Quote> lookup(const std::vector<std::string>& symbols,
+                            uint32_t* epoch, uint32_t* seq);
+
+  /**
+   * @brief Symbols some device asked for within the expiry window.
+   *
+   * Expired and rejected symbols are dropped.  Sorted, so the upstream
+   * request path is stable while the set does not change.
+   */
+  std::vector<std::string> wanted();
+
+  /// Store the latest prices (keyed by base asset) and bump the sequence.
+  void update_prices(const std::map<std::string, int64_t>& prices, uint32_t epoch);
+
+  /// Store midnight-UTC opens (keyed by base asset).
+  void update_opens(const std::map<std::string, int64_t>& opens);
+
+  /// Stop polling @p symbol: the exchange does not list it.  Devices get -1.
+  void reject(const std::string& symbol);
+
+ private:
+  struct Entry {
+    Quote             quote;
+    Clock::time_point last_wanted;
+  };
+
+  std::mutex                   mutex_;
+  std::chrono::seconds         expiry_;
+  std::map<std::string, Entry> entries_;
+  std::set<std::string>        rejected_;
+  uint32_t                     epoch_ = 0;
+  uint32_t                     seq_   = 0;
+};
+
+}  // namespace agg
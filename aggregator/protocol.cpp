@@ -0,0 +1,57 @@
+/**
+ * @file protocol.cpp
+ * @brief Frame encoding and decimal parsing.
+ */
+
+#include "protocol.h"
+
+namespace agg {
+
+static void put_le(std::string& out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void encode_frame(std::string& out, uint32_t epoch, uint32_t seq,
+                  const std::vector<Quote>& quotes) {
+  out.reserve(out.size() + FRAME_HEADER_SIZE + FRAME_RECORD_SIZE * quotes.size());
+  put_le(out, FRAME_MAGIC, 4);
+  put_le(out, quotes.size(), 2);
+  put_le(out, 0, 2);
+  put_le(out, epoch, 4);
+  put_le(out, seq, 4);
+  for (const Quote& q : quotes) {
+    put_le(out, static_cast<uint64_t>(q.price), 8);
+    put_le(out, static_cast<uint64_t>(q.open), 8);
+  }
+}
+
+int64_t parse_price(const char* text, size_t len) {
+  size_t  i     = 0;
+  int64_t whole = 0;
+  for (; i < len && text[i] >= '0' && text[i] <= '9'; i++) whole = whole * 10 + (text[i] - '0');
+  if (i == 0) return PRICE_UNKNOWN;
+
+  int64_t frac   = 0;
+  int     digits = 0;
+  if (i < len && text[i] == '.') {
+    for (i++; i < len && text[i] >= '0' && text[i] <= '9'; i++) {
+      if (digits < 8) {
+        frac = frac * 10 + (text[i] - '0');
+        digits++;
+      }
+    }
+  }
+  if (i != len) return PRICE_UNKNOWN;
+  for (; digits < 8; digits++) frac *= 10;
+  return whole * PRICE_SCALE + frac;
+}
+
+bool valid_symbol(const std::string& symbol) {
+  if (symbol.empty() || symbol.size() > 10) return false;
+  for (char c : symbol) {
+    if (!((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) return false;
+  }
+  return true;
+}
+
+}  // namespace agg
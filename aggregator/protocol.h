@@ -0,0 +1,64 @@
+/**
+ * @file protocol.h
+ * @brief Binary price frame served by the aggregator to the trackers.
+ *
+ * A tracker asks for its watchlist with a plain HTTP request:
+ * @code
+ * GET /v1/prices?symbols=BTC,ETH HTTP/1.1
+ * @endcode
+ * and gets back an @c application/octet-stream body of fixed layout,
+ * all fields little-endian:
+ *
+ * | Offset      | Size | Field                                             |
+ * |-------------|------|---------------------------------------------------|
+ * | 0           | 4    | magic @c "BTK1"                                   |
+ * | 4           | 2    | record count (= number of requested symbols)      |
+ * | 6           | 2    | reserved, 0                                       |
+ * | 8           | 4    | UTC seconds of the last upstream price update     |
+ * | 12          | 4    | upstream update sequence number                   |
+ * | 16 + 16·i   | 8    | price of symbol i, in 1e-8 units (-1 = unknown)   |
+ * | 24 + 16·i   | 8    | midnight-UTC open of symbol i, same units         |
+ *
+ * Records are in the order the symbols were requested, so the device can
+ * copy them straight into its arrays without any parsing or lookup.  The
+ * device side of this layout lives in
+ * bitcoin-tracker-oled/aggregator_client.cpp; keep the two in sync.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace agg {
+
+constexpr uint32_t FRAME_MAGIC       = 0x314B5442;   ///< "BTK1" read as little-endian
+constexpr size_t   FRAME_HEADER_SIZE = 16;
+constexpr size_t   FRAME_RECORD_SIZE = 16;
+constexpr int64_t  PRICE_UNKNOWN     = -1;
+
+/// Fixed-point scale shared with the device (price.h): 1 unit = 1e-8.
+constexpr int64_t  PRICE_SCALE       = 100000000;
+
+/// Longest watchlist one request may ask for.
+constexpr size_t   MAX_SYMBOLS       = 64;
+
+struct Quote {
+  int64_t price = PRICE_UNKNOWN;
+  int64_t open  = PRICE_UNKNOWN;
+};
+
+/// Append the frame for @p quotes to @p out.
+void encode_frame(std::string& out, uint32_t epoch, uint32_t seq,
+                  const std::vector<Quote>& quotes);
+
+/**
+ * @brief Parse a Binance decimal string ("60950.01000000") into 1e-8 units.
+ * @return The value, or @c PRICE_UNKNOWN if @p text is not a plain decimal.
+ */
+int64_t parse_price(const char* text, size_t len);
+
+/// True for a plausible Binance base asset: 1–10 of [A-Z0-9].
+bool valid_symbol(const std::string& symbol);
+
+}  // namespace agg
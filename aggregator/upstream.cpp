@@ -0,0 +1,220 @@
+/**
+ * @file upstream.cpp
+ * @brief Keep-alive HTTPS client implementation.
+ */
+
+#include "upstream.h"
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <openssl/err.h>
+
+#include "protocol.h"
+
+namespace agg {
+
+Upstream::Upstream(std::string host, uint16_t port) : host_(std::move(host)), port_(port) {
+  ctx_ = SSL_CTX_new(TLS_client_method());
+  SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+  SSL_CTX_set_default_verify_paths(ctx_);
+  SSL_CTX_set_verify(ctx_, SSL_VERIFY_PEER, nullptr);
+}
+
+Upstream::~Upstream() {
+  close();
+  SSL_CTX_free(ctx_);
+}
+
+bool Upstream::connect() {
+  addrinfo  hints{};
+  addrinfo* res = nullptr;
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  std::string service = std::to_string(port_);
+  if (getaddrinfo(host_.c_str(), service.c_str(), &hints, &res) != 0) {
+    fprintf(stderr, "[upstream] DNS lookup for %s failed\n", host_.c_str());
+    return false;
+  }
+  for (addrinfo* ai = res; ai; ai = ai->ai_next) {
+    fd_ = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd_ < 0) continue;
+    if (::connect(fd_, ai->ai_addr, ai->ai_addrlen) == 0) break;
+    ::close(fd_);
+    fd_ = -1;
+  }
+  freeaddrinfo(res);
+  if (fd_ < 0) {
+    fprintf(stderr, "[upstream] connect to %s failed\n", host_.c_str());
+    return false;
+  }
+
+  timeval timeout{10, 0};
+  setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  ssl_ = SSL_new(ctx_);
+  SSL_set_fd(ssl_, fd_);
+  SSL_set_tlsext_host_name(ssl_, host_.c_str());
+  SSL_set1_host(ssl_, host_.c_str());
+  if (SSL_connect(ssl_) != 1) {
+    fprintf(stderr, "[upstream] TLS handshake with %s failed: %s\n", host_.c_str(),
+            ERR_error_string(ERR_get_error(), nullptr));
+    close();
+    return false;
+  }
+  return true;
+}
+
+void Upstream::close() {
+  if (ssl_) {
+    SSL_free(ssl_);
+    ssl_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  rx_.clear();
+}
+
+int Upstream::get(const std::string& path, std::string& body) {
+  std::string request = "GET " + path + " HTTP/1.1\r\n"
+                        "Host: " + host_ + "\r\n"
+                        "Connection: keep-alive\r\n"
+                        "\r\n";
+
+  // A reused session may have been closed by the server while idle: retry
+  // once on a fresh connection before reporting failure.
+  for (int attempt = 0; attempt < 2; attempt++) {
+    if (!ssl_ && !connect()) return -1;
+    int status = exchange(request, body);
+    if (status > 0) return status;
+    close();
+  }
+  return -1;
+}
+
+int Upstream::exchange(const std::string& request, std::string& body) {
+  if (SSL_write(ssl_, request.data(), static_cast<int>(request.size())) <= 0) return -1;
+
+  std::string line;
+  if (!read_line(line)) return -1;
+  // "HTTP/1.1 200 OK"
+  size_t space = line.find(' ');
+  if (space == std::string::npos) return -1;
+  int status = atoi(line.c_str() + space + 1);
+
+  long content_length = -1;
+  bool chunked        = false;
+  bool keep_alive     = true;
+  while (read_line(line) && !line.empty()) {
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) continue;
+    std::string name  = line.substr(0, colon);
+    std::string value = line.substr(colon + 1);
+    value.erase(0, value.find_first_not_of(' '));
+    if (strcasecmp(name.c_str(), "Content-Length") == 0) {
+      content_length = atol(value.c_str());
+    } else if (strcasecmp(name.c_str(), "Transfer-Encoding") == 0) {
+      chunked = strcasecmp(value.c_str(), "chunked") == 0;
+    } else if (strcasecmp(name.c_str(), "Connection") == 0) {
+      keep_alive = strcasecmp(value.c_str(), "close") != 0;
+    }
+  }
+
+  body.clear();
+  if (chunked) {
+    for (;;) {
+      if (!read_line(line)) return -1;
+      size_t size = strtoul(line.c_str(), nullptr, 16);
+      if (size == 0) {
+        read_line(line);                           // trailing CRLF
+        break;
+      }
+      if (!read_exact(size, body) || !read_line(line)) return -1;
+    }
+  } else if (content_length >= 0) {
+    if (!read_exact(static_cast<size_t>(content_length), body)) return -1;
+  } else {
+    while (fill()) {}                              // body runs until close
+    body.swap(rx_);
+    keep_alive = false;
+  }
+
+  if (!keep_alive) close();
+  return status;
+}
+
+bool Upstream::fill() {
+  char buf[4096];
+  int  n = SSL_read(ssl_, buf, sizeof(buf));
+  if (n <= 0) return false;
+  rx_.append(buf, n);
+  return true;
+}
+
+bool Upstream::read_line(std::string& line) {
+  size_t end;
+  while ((end = rx_.find("\r\n")) == std::string::npos) {
+    if (!fill()) return false;
+  }
+  line.assign(rx_, 0, end);
+  rx_.erase(0, end + 2);
+  return true;
+}
+
+bool Upstream::read_exact(size_t len, std::string& out) {
+  while (rx_.size() < len) {
+    if (!fill()) return false;
+  }
+  out.append(rx_, 0, len);
+  rx_.erase(0, len);
+  return true;
+}
+
+// ─── JSON ──────────────────────────────────────────────────────────────────
+
+/// Value of the string field @p key inside @p obj, or empty if absent.
+static std::string string_field(const std::string& obj, const std::string& key) {
+  std::string needle = "\"" + key + "\":\"";
+  size_t      start  = obj.find(needle);
+  if (start == std::string::npos) return {};
+  start += needle.size();
+  size_t end = obj.find('"', start);
+  if (end == std::string::npos) return {};
+  return obj.substr(start, end - start);
+}
+
+std::map<std::string, int64_t> parse_symbol_field(const std::string& json,
+                                                  const char* field,
+                                                  const char* quote) {
+  std::map<std::string, int64_t> values;
+  size_t quote_len = strlen(quote);
+
+  // Both endpoints return an array of flat objects, so each object simply
+  // runs from one '{' to the next '}'.
+  for (size_t pos = json.find('{'); pos != std::string::npos; pos = json.find('{', pos)) {
+    size_t end = json.find('}', pos);
+    if (end == std::string::npos) break;
+    std::string obj = json.substr(pos, end - pos);
+    pos             = end;
+
+    std::string symbol = string_field(obj, "symbol");
+    if (symbol.size() <= quote_len ||
+        symbol.compare(symbol.size() - quote_len, quote_len, quote) != 0) {
+      continue;
+    }
+    std::string text  = string_field(obj, field);
+    int64_t     price = parse_price(text.data(), text.size());
+    if (price != PRICE_UNKNOWN) values[symbol.substr(0, symbol.size() - quote_len)] = price;
+  }
+  return values;
+}
+
+}  // namespace agg
@@ -0,0 +1,61 @@
+/**
+ * @file upstream.h
+ * @brief Keep-alive HTTPS client for the Binance REST API.
+ *
+ * The aggregator is the only thing in the fleet that talks to the exchange,
+ * so one TLS session is opened and reused for every poll.  Calls block; the
+ * poller thread is the only user.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <openssl/ssl.h>
+
+namespace agg {
+
+class Upstream {
+ public:
+  explicit Upstream(std::string host, uint16_t port = 443);
+  ~Upstream();
+
+  Upstream(const Upstream&)            = delete;
+  Upstream& operator=(const Upstream&) = delete;
+
+  /**
+   * @brief GET @p path, reconnecting once if the kept-alive session died.
+   * @param body  Receives the response body.
+   * @return HTTP status code, or -1 on a connection or protocol error.
+   */
+  int get(const std::string& path, std::string& body);
+
+ private:
+  bool connect();
+  void close();
+  int  exchange(const std::string& request, std::string& body);
+  bool read_line(std::string& line);
+  bool read_exact(size_t len, std::string& out);
+  bool fill();
+
+  std::string host_;
+  uint16_t    port_;
+  SSL_CTX*    ctx_  = nullptr;
+  SSL*        ssl_  = nullptr;
+  int         fd_   = -1;
+  std::string rx_;            ///< bytes read from TLS but not yet consumed
+};
+
+/**
+ * @brief Extract one decimal field from a batched Binance response.
+ *
+ * Parses @c [{"symbol":"BTCUSDT",...,"<field>":"60950.01",...},...] and
+ * returns base asset → price in 1e-8 units.  Symbols without the
+ * @p quote suffix are ignored.
+ */
+std::map<std::string, int64_t> parse_symbol_field(const std::string& json,
+                                                  const char* field,
+                                                  const char* quote);
+
+}  // namespace agg
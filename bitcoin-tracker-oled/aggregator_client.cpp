@@ -0,0 +1,153 @@
+/**
+ * @file aggregator_client.cpp
+ * @brief LAN aggregator client implementation.
+ *
+ * The frame layout below must match aggregator/protocol.h.
+ */
+
+#include "aggregator_client.h"
+
+#include <ESP8266WiFi.h>
+
+#include "api.h"
+#include "config.h"
+#include "debug.h"
+#include "watchlist.h"
+
+#define AGG_TIMEOUT_MS      2000
+#define AGG_HEADER_LINE     96
+
+// " HTTP/1.1\r\nHost: <AGGREGATOR_HOST>\r\n\r\n" after the request line
+#define AGG_REQUEST_HEADERS 96
+
+// "GET /v1/prices?symbols=BTC,ETH", built in flash
+static constexpr WatchlistJoin JOIN_REQUEST = {"GET /v1/prices?symbols=", "", "", ",", "", false};
+WATCHLIST_TEXT(AGG_REQUEST_LINE, JOIN_REQUEST);
+
+#define AGG_REQUEST_BUFFER  (sizeof(AGG_REQUEST_LINE) + AGG_REQUEST_HEADERS)
+
+static_assert(AGG_REQUEST_BUFFER <= REQUEST_STACK_BYTES,
+              "list_of_symbols: the aggregator request outgrows REQUEST_STACK_BYTES");
+
+// ── Frame layout (aggregator/protocol.h) ──────────────────────────────────────
+#define AGG_FRAME_MAGIC     0x314B5442UL    // "BTK1" read as little-endian
+#define AGG_HEADER_SIZE     16
+#define AGG_RECORD_SIZE     16
+
+static WiFiClient    client;
+static unsigned long request_start = 0;
+
+/// Little-endian integer of @p bytes bytes starting at @p p.
+static uint64_t read_le(const uint8_t* p, uint8_t bytes) {
+  uint64_t value = 0;
+  for (uint8_t i = bytes; i-- > 0;) value = (value << 8) | p[i];
+  return value;
+}
+
+static void report_error(const __FlashStringHelper* what) {
+  Serial.print(F("[aggregator] "));
+  Serial.println(what);
+}
+
+/// Status code, with the body length in @p length; -1 on a malformed response.
+static int read_headers(long* length) {
+  char line[AGG_HEADER_LINE];
+  int  code = -1;
+  *length   = -1;
+
+  for (bool first = true;; first = false) {
+    size_t n = client.readBytesUntil('\n', line, sizeof(line) - 1);
+    if (n == 0) return -1;                      // timed out
+    if (line[n - 1] == '\r') n--;
+    line[n] = '\0';
+    if (n == 0) break;                          // blank line: end of headers
+
+    if (first) {
+      if (strncmp_P(line, PSTR("HTTP/1."), 7) != 0 || n < 12) return -1;
+      code = atoi(line + 9);
+    } else if (strncasecmp_P(line, PSTR("Content-Length:"), 15) == 0) {
+      *length = atol(line + 15);
+    }
+  }
+  return code;
+}
+
+bool aggregator_request() {
+  if (!client.connected()) {
+    client.stop();
+    client.setTimeout(AGG_TIMEOUT_MS);
+    client.setNoDelay(true);
+    if (!client.connect(AGGREGATOR_HOST, AGGREGATOR_PORT)) {
+      report_error(F("connect failed"));
+      return false;
+    }
+  }
+
+  // "GET /v1/prices?symbols=BTC,ETH HTTP/1.1\r\nHost: ...\r\n\r\n" in one write
+  char request[AGG_REQUEST_BUFFER];
+  size_t len = strlcpy_P(request, AGG_REQUEST_LINE.text, sizeof(request));
+  len += snprintf_P(request + len, sizeof(request) - len,
+                    PSTR(" HTTP/1.1\r\nHost: %s\r\n\r\n"), AGGREGATOR_HOST);
+  if (len >= sizeof(request)) {
+    report_error(F("request too long"));
+    return false;
+  }
+  DEBUG_PRINT(request);
+
+  if (client.write((const uint8_t*)request, len) != len) {
+    report_error(F("send failed"));
+    client.stop();
+    return false;
+  }
+  request_start = millis();
+  return true;
+}
+
+int aggregator_poll(price_t* prices, price_t* opens, uint32_t* epoch) {
+  if (!client.available()) {
+    if (client.connected() && millis() - request_start < AGG_TIMEOUT_MS) return API_PENDING;
+    report_error(F("no response"));
+    client.stop();
+    return -1;
+  }
+
+  long length;
+  int  code = read_headers(&length);
+  if (code != 200 || length != AGG_HEADER_SIZE + AGG_RECORD_SIZE * (long)size_of_list_of_symbols) {
+    report_error(F("unexpected response"));
+    client.stop();                              // resync on a fresh connection
+    return -1;
+  }
+
+  uint8_t buf[AGG_HEADER_SIZE];
+  if (client.readBytes(buf, AGG_HEADER_SIZE) != AGG_HEADER_SIZE
+      || read_le(buf, 4) != AGG_FRAME_MAGIC
+      || read_le(buf + 4, 2) != (uint64_t)size_of_list_of_symbols) {
+    report_error(F("bad frame"));
+    client.stop();
+    return -1;
+  }
+  *epoch = (uint32_t)read_le(buf + 8, 4);
+
+  // Records are in request order, i.e. indexed like list_of_symbols[]
+  int updated = 0;
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    if (client.readBytes(buf, AGG_RECORD_SIZE) != AGG_RECORD_SIZE) {
+      report_error(F("truncated frame"));
+      client.stop();
+      return -1;
+    }
+    price_t price = (price_t)read_le(buf, 8);
+    price_t open  = (price_t)read_le(buf + 8, 8);
+    if (price > 0) {
+      prices[i] = price;
+      updated++;
+    }
+    if (open > 0) opens[i] = open;
+  }
+  return updated;
+}
+
+void aggregator_close() {
+  client.stop();
+}
@@ -0,0 +1,41 @@
+/**
+ * @file aggregator_client.h
+ * @brief Fetch prices from a LAN tracker-aggregator instead of Binance.
+ *
+ * Enabled with @c USE_AGGREGATOR in config.h.  One aggregator (see the
+ * aggregator/ directory) polls Binance for the whole fleet; each tracker
+ * asks it for its watchlist over plain HTTP on the local network:
+ * @code
+ * GET /v1/prices?symbols=BTC,ETH HTTP/1.1
+ * @endcode
+ * and gets back a fixed-layout binary frame with the price and daily open
+ * of every symbol (aggregator/protocol.h).  No TLS, no JSON: the response
+ * is copied into the price arrays as it is read.
+ *
+ * Same non-blocking request/poll pattern as api.h.
+ */
+#pragma once
+
+#include "price.h"
+
+/**
+ * @brief Send the watchlist request, connecting first if needed.
+ * @return true if the request was sent.
+ */
+bool aggregator_request();
+
+/**
+ * @brief Check on the request started by @ref aggregator_request.
+ *
+ * Returns immediately while the aggregator has not answered.  Symbols the
+ * aggregator has no value for yet are left untouched.
+ *
+ * @param prices  Array indexed like @c list_of_symbols[]; receives prices.
+ * @param opens   Array indexed like @c list_of_symbols[]; receives daily opens.
+ * @param epoch   Receives the UTC time of the aggregator's last update (0 if none yet).
+ * @return @c API_PENDING, the number of prices received, or -1 on error.
+ */
+int aggregator_poll(price_t* prices, price_t* opens, uint32_t* epoch);
+
+/// Drop the connection; the next request reconnects.
+void aggregator_close();
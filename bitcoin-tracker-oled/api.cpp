@@ -2,139 +2,340 @@
  * @file api.cpp
  * @brief Binance REST API implementation.
  *
- * Uses WiFiClientSecure (BearSSL) with deliberately reduced TLS buffers to
- * keep heap usage around 28 KB instead of the default ~60 KB.  Certificate
- * verification is disabled (setInsecure) — acceptable for a personal project
- * where authenticity of the price data is not safety-critical.
+ * All requests go through the persistent keep-alive connection managed by
+ * connection.cpp, so a poll normally reuses an open TLS socket instead of
+ * paying a full handshake.  The reduced BearSSL buffers from config.h keep
+ * heap usage around 28 KB instead of the default ~60 KB.
  *
- * Both functions parse the HTTP response directly from the stream using
- * ArduinoJson, so the full payload is never materialised as a String.
+ * Batched request paths name the whole watchlist and are rendered into
+ * flash at compile time (watchlist.h); the klines path is composed from a
+ * PROGMEM template into a fixed stack buffer.  Responses are fed byte by
+ * byte into the allocation-free JsonScanner (json_scanner.h) as they
+ * arrive: the parse state lives between poll_*() calls, so a body that
+ * trickles in never holds up the loop.  No String, no JSON document, and
+ * nothing on the heap per request.
  */
 
 #include "api.h"
 
 #include <Arduino.h>
-#include <ESP8266HTTPClient.h>
-#include <WiFiClientSecure.h>
-
-// Must be defined before including ArduinoJson to ensure 64-bit float arithmetic.
-#define ARDUINOJSON_USE_DOUBLE 1
-#include <ArduinoJson.h>
+#include <ESP8266HTTPClient.h>   // HTTP_CODE_* constants
 
 #include "config.h"
+#include "connection.h"
 #include "debug.h"
+#include "json_scanner.h"
+#include "watchlist.h"
+
+// Room for the klines path (the batched ones are sized by the compiler).
+#define API_PATH_BUFFER 96
+
+// Body bytes parsed per poll_*() call; a long body is spread over several
+// scheduler ticks instead of being parsed in one go.
+#define API_PARSE_SLICE 512
+
+// ── Request templates (flash) ────────────────────────────────────────────────
+
+static const char PATH_CHART[]       PROGMEM =
+    "/api/v3/klines?symbol=%sUSDT&interval=" CHART_INTERVAL "&limit=%u";
+
+static const char KEY_SYMBOL[]       PROGMEM = "symbol";
+static const char KEY_PRICE[]        PROGMEM = "price";
+static const char KEY_OPEN_PRICE[]   PROGMEM = "openPrice";
+
+// ── Batched paths (flash, rendered at compile time) ──────────────────────────
+// The symbols parameter is the JSON array ["BTCUSDT","ETHUSDT"] with brackets
+// and quotes URL-encoded.
+
+static constexpr WatchlistJoin JOIN_TICKERS = {
+  "/api/v3/ticker/price?symbols=%5B", "%22", "USDT%22", ",", "%5D", false,
+};
+static constexpr WatchlistJoin JOIN_TRADING_DAY = {
+  "/api/v3/ticker/tradingDay?symbols=%5B", "%22", "USDT%22", ",", "%5D&type=MINI", false,
+};
+
+WATCHLIST_TEXT(PATH_TICKERS,     JOIN_TICKERS);
+WATCHLIST_TEXT(PATH_TRADING_DAY, JOIN_TRADING_DAY);
+
+static_assert(sizeof(PATH_TRADING_DAY) <= REQUEST_STACK_BYTES,
+              "list_of_symbols: the batched request path outgrows REQUEST_STACK_BYTES");
+static_assert(sizeof(PATH_TRADING_DAY) + CONN_REQUEST_HEADERS <= CONN_REQUEST_BUFFER,
+              "list_of_symbols: the batched request outgrows CONN_REQUEST_BUFFER (connection.h)");
 
 // ─────────────────────────────────────────────────────────────────────────────
-// Internal helper
+// Internal helpers
 // ─────────────────────────────────────────────────────────────────────────────
 
+/// Parse of the response in flight, kept across poll_*() calls while its body arrives.
+struct ResponseParse {
+  JsonScanner json;
+  bool        started;       ///< headers are in; the body is being parsed
+  int         index;         ///< batch: slot of the element being read, or -1
+  int         updated;       ///< batch: slots filled so far
+  price_t     fields[4];     ///< batch: [0] the wanted field; klines: open, high, low, close
+};
+
+static ResponseParse parse;
+
+static_assert(sizeof(ResponseParse) <= API_PARSE_BYTES,
+              "ResponseParse outgrew API_PARSE_BYTES (api.h)");
+
+/// Log a failed request: a negative CONN_ERROR_* code or an unexpected status.
+static void report_http_error(int code, const __FlashStringHelper* label) {
+  Serial.print(F("[api] HTTP error ("));
+  Serial.print(label);
+  Serial.print(F("): "));
+  Serial.print(code);
+  Serial.print(F(" | error: "));
+  Serial.println(conn_error_to_string(code));
+}
+
+/// Log a response body that did not contain what we were looking for.
+static void report_parse_error(const __FlashStringHelper* label) {
+  Serial.print(F("[api] JSON error ("));
+  Serial.print(label);
+  Serial.println(F("): unexpected or truncated response"));
+}
+
+/// Finish the request in flight and log its latency breakdown in debug builds.
+static void end_request() {
+  digitalWrite(BUILTIN_LED, HIGH);
+  parse.started = false;
+  conn_end();
+#ifdef DEBUG
+  const ConnTiming& t = conn_last_timing();
+  Serial.printf_P(PSTR("[api] handshake %lu ms%s | request %lu ms\n"),
+                  t.handshake_ms, t.reused ? " (reused)" : "", t.request_ms);
+#endif
+}
+
 /**
- * @brief Apply standard TLS settings to a WiFiClientSecure instance.
+ * @brief Wait for the response headers, then set up the parse of the body.
  *
- * Called once per request before HTTPClient::begin().  Keeping this in one
- * place makes it easy to tighten security (e.g. add a certificate fingerprint)
- * without touching every call-site.
+ * @return 0 once the body is ready to parse, @c API_PENDING while the
+ *         headers have not arrived, or -1 on error (reported, and the
+ *         request finished).
+ */
+static int await_headers(const __FlashStringHelper* label) {
+  if (parse.started) return 0;
+
+  int code = conn_poll();
+  if (code == CONN_PENDING) return API_PENDING;
+  if (code != HTTP_CODE_OK) {
+    report_http_error(code, label);
+    end_request();
+    return -1;
+  }
+
+  parse.json.reset();
+  parse.started = true;
+  parse.index   = -1;
+  parse.updated = 0;
+  for (uint8_t i = 0; i < 4; i++) parse.fields[i] = -1;
+  return 0;
+}
+
+/**
+ * @brief Next body byte for a parser, at most API_PARSE_SLICE per poll.
  *
- * Timeout is set to 5000 ms (5 seconds) — adequate for Binance API in most
- * network conditions. If you still see -5 errors on slow WiFi, increase this.
+ * @param budget  Bytes left in this poll's slice; decremented.
+ * @return The byte, @c CONN_BODY_PENDING when the parser should come back
+ *         on a later poll, or -1 at the end of the body.
  */
-static void configure_tls(WiFiClientSecure& client) {
-  client.setInsecure();                              // skip certificate verification
-  client.setBufferSizes(TLS_READ_BUFFER, TLS_WRITE_BUFFER);
-  client.setTimeout(5000);                           // 5 second timeout
+static int next_byte(uint16_t& budget) {
+  if (budget == 0) return CONN_BODY_PENDING;
+  budget--;
+  return conn_body_read();
 }
 
-// ─────────────────────────────────────────────────────────────────────────────
-// Public API
-// ─────────────────────────────────────────────────────────────────────────────
+// Not static: also used by price_stream.cpp (declared in api.h).
+int find_symbol_index(const char* pair) {
+  if (pair == nullptr) return -1;
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    size_t len = strlen(list_of_symbols[i]);
+    if (strncmp(pair, list_of_symbols[i], len) == 0
+        && strcmp(pair + len, "USDT") == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
 
-double get_current_price(const char* symbol) {
-  WiFiClientSecure client;
-  configure_tls(client);
+/**
+ * @brief Copy one decimal field per element of a batched response into @p prices.
+ *
+ * Binance answers batched requests with a flat JSON array of small objects.
+ * The body is scanned byte by byte as it arrives; the @c symbol and
+ * @p field_P values of each element are remembered until its closing brace,
+ * then committed to the matching slot.  Memory use is constant regardless
+ * of the watchlist length.
+ *
+ * @param field_P Name of the decimal-string field to extract (PROGMEM).
+ * @param label   Short tag used in Serial error messages.
+ * @param prices  Output array indexed like list_of_symbols[].
+ * @return @c API_PENDING until the body has been read, then the number of
+ *         slots updated, or -1 on parse error.
+ */
+static int parse_batch(PGM_P field_P, const __FlashStringHelper* label, price_t* prices) {
+  JsonScanner& json   = parse.json;
+  uint16_t     budget = API_PARSE_SLICE;
+  int          c;
 
-  HTTPClient http;
-  
-  String url = String(F("https://")) + BINANCE_HOST
-             + F("/api/v3/ticker/price?symbol=") + symbol + F("USDT");
-  DEBUG_PRINT(url);
+  while ((c = next_byte(budget)) >= 0) {
+    if (json.done()) continue;              // past the array: only framing left
+    uint8_t events = json.feed((char)c);
 
-  http.begin(client, url);
-  http.addHeader(F("Connection"), F("close"));      // keep connections short
-  digitalWrite(BUILTIN_LED, LOW);   // blink LED while request is in flight
-  int code = http.GET();
-  digitalWrite(BUILTIN_LED, HIGH);
+    if ((events & JSON_VALUE) && json.depth() == 2) {
+      if      (json.key_is(KEY_SYMBOL)) parse.index     = find_symbol_index(json.value());
+      else if (json.key_is(field_P))    parse.fields[0] = price_parse(json.value());
+    }
 
-  double price = -1;
+    // An element object just closed: back at the array level
+    if ((events & JSON_END) && json.depth() == 1) {
+      if (parse.index >= 0 && parse.fields[0] > 0) {
+        prices[parse.index] = parse.fields[0];
+        DEBUG_PRINT(parse.fields[0]);
+        parse.updated++;
+      }
+      parse.index     = -1;
+      parse.fields[0] = -1;
+    }
+  }
+  if (c == CONN_BODY_PENDING) return API_PENDING;
 
-  if (code == HTTP_CODE_OK) {
-    // Discard everything except the single "price" field to minimise the
-    // amount of memory ArduinoJson allocates for the parsed document.
-    StaticJsonDocument<32> filter;
-    filter[F("price")] = true;
+  if (!json.done()) {
+    report_parse_error(label);
+    return -1;
+  }
+  return parse.updated;
+}
+
+/**
+ * @brief Reduce a klines response into @p chart, one candle at a time.
+ *
+ * Each candle is a flat array [openTime, open, high, low, close, volume, ...];
+ * elements 1–4 are kept until its closing bracket, then packed into the chart
+ * and forgotten.  The scanner state and four prices are all the parse needs.
+ *
+ * @return @c API_PENDING until the body has been read, then the number of
+ *         candles held, or -1 on parse error (chart left empty).
+ */
+static int parse_klines(CandleChart& chart) {
+  JsonScanner& json   = parse.json;
+  price_t*     ohlc   = parse.fields;
+  uint16_t     budget = API_PARSE_SLICE;
+  int          c;
 
-    StaticJsonDocument<64> doc;
-    DeserializationError err = deserializeJson(
-        doc, http.getStream(), DeserializationOption::Filter(filter));
+  while ((c = next_byte(budget)) >= 0) {
+    if (json.done()) continue;
+    uint8_t events = json.feed((char)c);
 
-    if (err) {
-      Serial.print(F("[api] JSON error (current): "));
-      Serial.println(err.f_str());
-    } else {
-      price = doc[F("price")].as<double>();
-      DEBUG_PRINT(price);
+    if ((events & JSON_VALUE) && json.depth() == 2) {
+      uint16_t field = json.index_at(2);
+      if (field >= 1 && field <= 4) ohlc[field - 1] = price_parse(json.value());
+    }
+
+    // A candle array just closed: back at the outer array
+    if ((events & JSON_END) && json.depth() == 1) {
+      if (ohlc[0] > 0 && ohlc[1] > 0 && ohlc[2] > 0 && ohlc[3] > 0) {
+        chart.add(ohlc[0], ohlc[1], ohlc[2], ohlc[3]);
+      }
+      for (uint8_t i = 0; i < 4; i++) ohlc[i] = -1;
     }
-  } else {
-    Serial.print(F("[api] HTTP error (current): "));
-    Serial.print(code);
-    Serial.print(F(" | error: "));
-    Serial.println(http.errorToString(code));
   }
+  if (c == CONN_BODY_PENDING) return API_PENDING;
 
-  http.end();
-  delay(100);   // brief pause before closing to allow graceful shutdown
-  return price;
+  if (!json.done()) {
+    report_parse_error(F("klines"));
+    chart.clear();
+    return -1;
+  }
+  chart.finish();
+  return chart.size();
 }
 
-double get_closing_price(const char* symbol) {
-  WiFiClientSecure client;
-  configure_tls(client);
+/**
+ * @brief Check on a batched request: wait for it, then parse as the body arrives.
+ * @return API_PENDING while waiting, else as parse_batch() (-1 on any error).
+ */
+static int poll_batch(PGM_P field_P, const __FlashStringHelper* label, price_t* prices) {
+  int ready = await_headers(label);
+  if (ready != 0) return ready;
 
-  HTTPClient http;
-  
-  String url = String(F("https://")) + BINANCE_HOST
-             + F("/api/v3/klines?symbol=") + symbol + F("USDT&interval=1d&limit=1");
-  DEBUG_PRINT(url);
+  int updated = parse_batch(field_P, label, prices);
+  if (updated != API_PENDING) end_request();
+  return updated;
+}
+
+/// Start a request for @p path; the LED stays lit until the matching poll finishes it.
+static bool send_path(const char* path, const __FlashStringHelper* label) {
+  DEBUG_PRINT(path);
 
-  http.begin(client, url);
-  http.addHeader(F("Connection"), F("close"));      // keep connections short
   digitalWrite(BUILTIN_LED, LOW);
-  int code = http.GET();
+  parse.started = false;                    // a request abandoned mid-body is forgotten
+  int code = conn_send(path);
+  if (code == 0) return true;
+
   digitalWrite(BUILTIN_LED, HIGH);
+  report_http_error(code, label);
+  return false;
+}
 
-  double price = -1;
-
-  if (code == HTTP_CODE_OK) {
-    // The klines response is ~160 bytes for limit=1; a 512-byte document is
-    // sufficient and a filter would add more complexity than it saves here.
-    StaticJsonDocument<512> doc;
-    DeserializationError err = deserializeJson(doc, http.getStream());
-
-    if (err) {
-      Serial.print(F("[api] JSON error (closing): "));
-      Serial.println(err.f_str());
-    } else {
-      // Klines layout: [[openTime, open, high, low, close, volume, closeTime, ...]]
-      price = doc[0][1].as<double>();
-      DEBUG_PRINT(price);
-    }
-  } else {
-    Serial.print(F("[api] HTTP error (closing): "));
-    Serial.print(code);
-    Serial.print(F(" | error: "));
-    Serial.println(http.errorToString(code));
-  }
+/// Start a batched request; see send_path().
+template <size_t N>
+static bool send_batch(const FlashText<N>& path_P, const __FlashStringHelper* label) {
+  char path[N];
+  strcpy_P(path, path_P.text);
+  return send_path(path, label);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Public API
+// ─────────────────────────────────────────────────────────────────────────────
+
+uint16_t current_prices_weight() {
+  return 4;                                   // flat for the symbols= form
+}
+
+uint16_t closing_prices_weight() {
+  // 4 per symbol, capped at 200 once the list exceeds 50 symbols
+  return (size_of_list_of_symbols > 50) ? 200 : 4 * size_of_list_of_symbols;
+}
+
+uint16_t klines_weight() {
+  return 2;                                   // flat for any limit up to 1000
+}
+
+bool request_current_prices() {
+  return send_batch(PATH_TICKERS, F("current"));
+}
+
+int poll_current_prices(price_t* prices) {
+  return poll_batch(KEY_PRICE, F("current"), prices);
+}
+
+bool request_closing_prices() {
+  return send_batch(PATH_TRADING_DAY, F("closing"));
+}
+
+int poll_closing_prices(price_t* prices) {
+  return poll_batch(KEY_OPEN_PRICE, F("closing"), prices);
+}
+
+bool request_klines(const char* symbol) {
+  char path[API_PATH_BUFFER];
+  snprintf_P(path, sizeof(path), PATH_CHART, symbol, (unsigned)CHART_CANDLES);
+  return send_path(path, F("klines"));
+}
+
+int poll_klines(CandleChart& chart) {
+  // The chart is refilled from empty once the headers are in (or failed)
+  bool waiting = !parse.started;
+  int  ready   = await_headers(F("klines"));
+  if (waiting && ready != API_PENDING) chart.clear();
+  if (ready != 0) return ready;
 
-  http.end();
-  delay(100);   // brief pause before closing to allow graceful shutdown
-  return price;
+  int candles = parse_klines(chart);
+  if (candles != API_PENDING) end_request();
+  return candles;
 }
@@ -2,50 +2,113 @@
  * @file api.h
  * @brief Binance REST API helpers for real-time price data.
  *
- * Both functions open a fresh HTTPS connection, parse the response as a
- * stream (no intermediate String allocation), and close the connection.
- * TLS buffer sizes are read from config.h (TLS_READ_BUFFER / TLS_WRITE_BUFFER).
+ * Every request goes over the persistent keep-alive HTTPS connection from
+ * connection.h, and its response is parsed as it arrives (no intermediate
+ * String allocation).  TLS buffer sizes are read from config.h
+ * (TLS_READ_BUFFER / TLS_WRITE_BUFFER).
+ *
+ * Requests come in request_*() / poll_*() pairs: the request goes out, and
+ * the poll, called from a scheduler task, returns @c API_PENDING until the
+ * whole response has been read, so rendering never waits on the network.
+ * The price requests cover the whole watchlist in one go.
  */
 #pragma once
 
+#include "candle_chart.h"
+#include "price.h"
+
+/// poll_*() result while the response has not arrived yet.
+#define API_PENDING -2
+
+/// RAM the response parser keeps between poll_*() calls.
+#define API_PARSE_BYTES 128
+
+/// Binance request weight of the batched current-price request (ticker/price).
+uint16_t current_prices_weight();
+
+/// Binance request weight of the batched daily-open request (ticker/tradingDay).
+uint16_t closing_prices_weight();
+
+/// Binance request weight of the candle request (klines).
+uint16_t klines_weight();
+
 /**
- * @brief Fetch the latest traded price for a symbol from Binance.
+ * @brief Map a Binance pair name (e.g. "ETHUSDT") back to its list_of_symbols index.
+ * @return Index into @c list_of_symbols[] (config.h), or -1 if the pair is not tracked.
+ */
+int find_symbol_index(const char* pair);
+
+/**
+ * @brief Start fetching the latest traded price of every symbol in one request.
  *
- * Endpoint: GET https://api.binance.com/api/v3/ticker/price?symbol=<SYMBOL>USDT
+ * Endpoint: GET https://api.binance.com/api/v3/ticker/price?symbols=["BTCUSDT","ETHUSDT"]
  *
- * Example response (≈60 bytes):
+ * Example response (≈50 bytes per symbol):
  * @code
- * {"symbol":"BTCUSDT","price":"60950.01000000"}
+ * [{"symbol":"BTCUSDT","price":"60950.01000000"},{"symbol":"ETHUSDT","price":"2950.10000000"}]
  * @endcode
  *
- * Memory strategy:
- *  - WiFiClientSecure with reduced TLS buffers (see config.h)
- *  - ArduinoJson filter  → only the "price" key is allocated in the document
- *  - Stream-based deserialization → response is never copied into a String
+ * Call @ref poll_current_prices until it stops returning @c API_PENDING.
+ * Only one request may be in flight at a time.
  *
- * @param symbol  Binance base asset (e.g. "BTC", "ETH").
- * @return Price as double, or -1 on HTTP/parse error.
+ * @return true if the request was sent.
+ */
+bool request_current_prices();
+
+/**
+ * @brief Check on the request started by @ref request_current_prices.
+ *
+ * Returns immediately.  The array is consumed one element at a time as it
+ * arrives, so memory use stays constant regardless of the watchlist length.
+ * Each element is matched back to its slot by the @c symbol field rather
+ * than by position, and written to @p prices as soon as it closes.
+ *
+ * @param prices  Output array indexed like @c list_of_symbols[] (config.h).
+ *                Slots missing from the response are left untouched.
+ * @return @c API_PENDING, the number of slots updated, or -1 on error.
+ */
+int poll_current_prices(price_t* prices);
+
+/**
+ * @brief Start fetching the midnight-UTC opening price of every symbol in one request.
+ *
+ * Endpoint: GET https://api.binance.com/api/v3/ticker/tradingDay?symbols=[...]&type=MINI
+ *
+ * The trading-day ticker defaults to @c timeZone=0, so its @c openPrice is
+ * the open of the current UTC day, the daily reference for the % change.
+ * Follow up with @ref poll_closing_prices.
  */
-double get_current_price(const char* symbol);
+bool request_closing_prices();
+
+/// Check on the request started by @ref request_closing_prices; see @ref poll_current_prices.
+int poll_closing_prices(price_t* prices);
 
 /**
- * @brief Fetch the midnight-UTC opening price for a symbol from Binance.
+ * @brief Start fetching the candles of one symbol for the chart screen.
  *
- * Endpoint: GET https://api.binance.com/api/v3/klines?symbol=<SYMBOL>USDT&interval=1d&limit=1
+ * Endpoint: GET https://api.binance.com/api/v3/klines
+ *             ?symbol=<SYMBOL>USDT&interval=<CHART_INTERVAL>&limit=<CHART_CANDLES>
  *
- * Example response (≈160 bytes):
+ * Example response (≈150 bytes per candle, ~10 KB for 64 candles):
  * @code
- * [[1499040000000,"60000.00","62000.00","59000.00","61000.00","12345.00",...]]
+ * [[1499040000000,"60000.00","62000.00","59000.00","61000.00","12345.00",...],...]
  * @endcode
  *
- * @c klines[0][1] is the open price of the current daily candle, which is the
- * price at exactly midnight UTC — semantically equivalent to CryptoCompare's
- * @c OPENDAY field. This value is used as the daily reference for % change.
- *
- * The response is small enough (≈160 bytes) that no filter is required;
- * a StaticJsonDocument<512> holds the full document comfortably.
+ * Follow up with @ref poll_klines, like @ref request_current_prices.
  *
  * @param symbol  Binance base asset (e.g. "BTC", "ETH").
- * @return Opening price as double, or -1 on HTTP/parse error.
+ * @return true if the request was sent.
+ */
+bool request_klines(const char* symbol);
+
+/**
+ * @brief Check on the request started by @ref request_klines.
+ *
+ * Once the response arrives, each candle is reduced to four bytes in
+ * @p chart as soon as its closing bracket is read (candle_chart.h), so
+ * memory use does not depend on the number of candles in the response.
+ * @p chart is emptied first, and left empty on error.
+ *
+ * @return @c API_PENDING, the number of candles held, or -1 on error.
  */
-double get_closing_price(const char* symbol);
+int poll_klines(CandleChart& chart);
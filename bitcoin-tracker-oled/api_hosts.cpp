@@ -0,0 +1,25 @@
+/**
+ * @file api_hosts.cpp
+ * @brief API host rotation and address freshness.
+ */
+
+#include "api_hosts.h"
+
+const char* ApiHosts::host() const {
+  return (current_ == 0) ? primary_ : fallbacks_[current_ - 1];
+}
+
+bool ApiHosts::fresh(unsigned long now_ms) const {
+  return resolved_ && now_ms - resolved_ms_ < ttl_ms_;
+}
+
+void ApiHosts::store(IPAddress address, unsigned long now_ms) {
+  address_     = address;
+  resolved_ms_ = now_ms;
+  resolved_    = true;
+}
+
+void ApiHosts::fail() {
+  resolved_ = false;
+  current_  = (current_ + 1) % (fallback_count_ + 1);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file api_hosts.h
+ * @brief Which Binance API host to use, and its last resolved address.
+ *
+ * Binance publishes several equivalent REST hosts (api.binance.com,
+ * api1…api4.binance.com).  The connection starts on @c BINANCE_HOST and
+ * moves to the next entry of @c BINANCE_FALLBACK_HOSTS whenever a lookup or
+ * a connect fails, wrapping around to the primary after the last one.
+ *
+ * The address of the current host is kept for @c DNS_CACHE_TTL_MS, which
+ * stays at or below the record's real TTL.  While it is fresh a reconnect
+ * skips the lookup and probes the address directly (connection.cpp); the
+ * TLS connect itself still takes the host name, which it needs for SNI, and
+ * lwIP answers that lookup from its own table.
+ *
+ * Like PollPlanner, nothing here reads millis() or touches the network.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+class ApiHosts {
+ public:
+  ApiHosts(const char* primary, const char* const* fallbacks, uint8_t fallback_count,
+           unsigned long ttl_ms)
+      : primary_(primary), fallbacks_(fallbacks), fallback_count_(fallback_count),
+        ttl_ms_(ttl_ms) {}
+
+  /// Host name to resolve, connect to and send as @c Host / SNI.
+  const char* host() const;
+
+  /// True while the address of host() was resolved less than the TTL ago.
+  bool fresh(unsigned long now_ms) const;
+
+  /// Last resolved address of host(); only meaningful while fresh().
+  IPAddress address() const { return address_; }
+
+  /// Record a successful lookup of host().
+  void store(IPAddress address, unsigned long now_ms);
+
+  /// host() did not resolve or did not answer: forget it and move to the next one.
+  void fail();
+
+ private:
+  const char*        primary_;
+  const char* const* fallbacks_;
+  uint8_t            fallback_count_;
+  unsigned long      ttl_ms_;
+  uint8_t            current_     = 0;      ///< 0 = primary, i = fallbacks_[i - 1]
+  IPAddress          address_;
+  unsigned long      resolved_ms_ = 0;
+  bool               resolved_    = false;
+};
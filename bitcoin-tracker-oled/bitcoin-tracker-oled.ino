@@ -1,6 +1,6 @@
 /**
  * @file bitcoin-tracker-oled.ino
- * @brief ESP8266 crypto price tracker with SH1106G OLED display.
+ * @brief ESP8266 crypto price tracker with an SH1106G OLED or 16×2 LCD display.
  *
  * Displays real-time prices and a daily-change indicator for one or more
  * crypto assets fetched directly from the Binance REST API over HTTPS.
@@ -8,13 +8,13 @@
  *
  * ── Hardware ────────────────────────────────────────────────────────────────
  *  - ESP8266 board (NodeMCU, Wemos D1 Mini, or compatible)
- *  - SH1106G 128×64 OLED via I2C (default address 0x3C)
+ *  - SH1106G 128×64 OLED via I2C (default address 0x3C), or
+ *    16×2 LCD with I2C backpack (default address 0x3F), see DISPLAY_BACKEND
  *    SDA → D1  |  SCL → D2  (configurable in config.h)
  *
  * ── Dependencies (Arduino Library Manager) ──────────────────────────────────
- *  - ArduinoJson  ≥ 6.x   (Benoit Blanchon)
- *  - Adafruit GFX Library
- *  - Adafruit SH110X
+ *  - OLED: Adafruit GFX Library, Adafruit SH110X
+ *  - LCD:  LiquidCrystal I2C
  *
  * ── Quick start ─────────────────────────────────────────────────────────────
  *  1. Open config.h and set your WiFi credentials and desired symbols.
@@ -22,113 +22,560 @@
  *  3. Done — no Docker, no proxy, no API key required.
  *
  * ── How it works ────────────────────────────────────────────────────────────
- *  setup():  Connects to WiFi, then for every symbol fetches
- *              • the midnight-UTC open price  (Binance klines, daily candle)
- *              • the latest traded price      (Binance ticker/price)
+ *  setup():  Initialises the OLED, draws the last prices from the flash
+ *            snapshot (boot_cache.h) marked as cached, starts WiFi on the
+ *            last access point and the task scheduler, and returns straight
+ *            away — nothing waits on the network.
  *
- *  loop():   Every poll_delay ms, re-fetches the current price for the
- *            active symbol and redraws the screen if the price changed.
- *            Symbols rotate every SECONDS_TO_DISPLAY_EACH_SYMBOL seconds.
+ *  loop():   Runs the cooperative scheduler (scheduler.h).  Each task is
+ *            short and non-blocking:
+ *              • wifi    — watches the connection, starts fetching once up
+ *              • fetch   — sends one batched request: the midnight-UTC
+ *                          opens first (ticker/tradingDay), then the latest
+ *                          prices (ticker/price) as planned by poll_planner.h
+ *                          — fast while the visible price moves, slower when
+ *                          idle, just ahead of each rotation, and never over
+ *                          the per-minute request-weight budget
+ *              • parse   — while a request is in flight, polls for the
+ *                          response and parses it once it arrives
+ *              • warm    — after each response, reopens the connection if
+ *                          the server closed it, so the next poll does not
+ *                          start with DNS and a TLS handshake
+ *              • stream  — with USE_WEBSOCKET_STREAM, replaces REST price
+ *                          polling with pushed miniTicker frames
+ *              • rollover — when the UTC day changes (clock kept from the
+ *                          API's Date header), refetches all daily opens
+ *                          in one batched request
+ *              • rotate  — every SECONDS_TO_DISPLAY_EACH_SYMBOL seconds;
+ *                          with SHOW_CANDLE_CHART each price screen is
+ *                          followed by the symbol's candle chart, whose
+ *                          klines are fetched while its price is on screen
+ *              • render  — redraws when the visible price or symbol changed
+ *              • animate — ANIM_FPS frames of the digit roll / flash that
+ *                          follows a price tick (price_anim.h); a frame
+ *                          that comes due while the loop is busy is
+ *                          dropped, never made up for
+ *              • snapshot — every BOOT_CACHE_SAVE_INTERVAL_MS saves prices,
+ *                          opens and WiFi details for the next warm boot
+ *            A slow network therefore delays fresh prices, but never the
+ *            symbol rotation or redraws.
+ *
+ *            With USE_AGGREGATOR, fetch asks a LAN tracker-aggregator for
+ *            prices and opens in one binary frame (aggregator_client.h)
+ *            instead, and the exchange is never contacted directly.
  *
  * ── Memory highlights ───────────────────────────────────────────────────────
- *  - Prices are stored in plain double[] arrays (no JSON document overhead).
+ *  - Prices are stored as fixed-point price_t[] arrays (price.h): exact
+ *    integer math end to end, no soft-float on the FPU-less ESP8266.
  *  - API responses are parsed as streams (never loaded into a String).
- *  - ArduinoJson filters ensure only needed fields are allocated.
+ *  - A byte-at-a-time JSON scanner (json_scanner.h) replaces ArduinoJson:
+ *    no document, no heap, request paths built from PROGMEM templates.
+ *  - The watchlist is checked at compile time, and the request paths that
+ *    name all of it are rendered into flash (watchlist.h).
+ *  - The static RAM plan must fit RAM_BUDGET_BYTES or the build fails
+ *    (memory_budget.h).
  *  - BearSSL TLS buffers are capped via config.h (~28 KB vs default ~60 KB).
+ *  - One keep-alive TLS connection is reused across polls (connection.h).
+ *  - Responses are awaited without blocking, so loop() never stalls.
+ *
+ * ── Diagnostics ─────────────────────────────────────────────────────────────
+ *  Per-phase timing histograms plus heap and stack gauges (metrics.h): type
+ *  "stats" in the Serial Monitor, or scrape http://<device-ip>/metrics.
+ *  "memory" prints the static RAM plan.
  */
 
 #include <ESP8266WiFi.h>
 #include <Wire.h>
 #include <avr/pgmspace.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SH110X.h>
 
 #include "config.h"
 #include "debug.h"
+#include "aggregator_client.h"
 #include "api.h"
-#include "display_utils.h"
+#include "boot_cache.h"
+#include "candle_chart.h"
+#include "connection.h"
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+  #include "display_lcd.h"
+#else
+  #include "display_oled.h"
+#endif
+#include "metrics.h"
+#include "poll_planner.h"
+#include "price_stream.h"
+#include "scheduler.h"
+#include "tick_history.h"
+#include "utc_clock.h"
+
+// The aggregator serves prices over plain HTTP; it takes precedence over the stream.
+#define STREAMING (USE_WEBSOCKET_STREAM && !USE_AGGREGATOR)
+
+// Candles are fetched over the REST connection between price polls.
+#define CHARTING (SHOW_CANDLE_CHART && !STREAMING && !USE_AGGREGATOR)
 
 // ── Globals ───────────────────────────────────────────────────────────────────
 
-Adafruit_SH1106G display(OLED_WIDTH, OLED_HEIGHT, &Wire, OLED_RESET);
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+LcdDisplay  screen;
+#else
+OledDisplay screen;
+#endif
 
 /// Last known price for each symbol (index mirrors list_of_symbols[]).
-double current_prices[size_of_list_of_symbols];
+price_t current_prices[size_of_list_of_symbols];
 
-/// Midnight-UTC open price for each symbol, fetched once at boot.
-double closing_prices[size_of_list_of_symbols];
+/// Midnight-UTC open price for each symbol, refetched at every UTC rollover.
+price_t closing_prices[size_of_list_of_symbols];
 
-int  symbol_index = 0;
-long start_time   = 0;
+/// Recent prices for each symbol, for the sparkline (index mirrors list_of_symbols[]).
+TickHistory price_history[size_of_list_of_symbols];
 
-// ─────────────────────────────────────────────────────────────────────────────
+/// UTC time from the API's Date header, and the day closing_prices[] is for.
+UtcClock    utc_clock;
+DayRollover opens_day;
 
-void setup() {
-  Serial.begin(9600);
+int     symbol_index = 0;
 
-  // OLED init
-  Wire.begin(OLED_SDA, OLED_SCL);
-  delay(250);
-  display.begin(OLED_I2C_ADDR, true);
-  display.setTextColor(SH110X_WHITE);
-  display.clearDisplay();
-  display.println(F("Connecting..."));
-  display.display();
+/// What is currently on screen (for the previous_price argument).
+int     shown_index  = -1;
+price_t shown_price  = 0;
 
-  // Built-in LED is active-low on most ESP8266 boards (HIGH = off)
-  pinMode(BUILTIN_LED, OUTPUT);
-  digitalWrite(BUILTIN_LED, HIGH);
+bool    wifi_up      = false;
+bool    have_opens   = false;
+bool    have_prices  = false;
+bool    screen_dirty = false;
+
+/// True while the prices on screen come from the boot snapshot, not the network.
+bool    prices_stale = false;
 
-  // Wi-Fi
-  WiFi.begin(ssid, password);
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(1000);
+/// Joining the cached access point; falls back to a scan if that times out.
+bool          wifi_fast_connect = false;
+unsigned long wifi_started_ms   = 0;
+
+/// When the last animation frame was drawn; 0 while no transition runs.
+unsigned long last_frame_ms = 0;
+
+/// Boot milestones already reported over Serial.
+bool    shown_first  = false;
+bool    shown_fresh  = false;
+
+/// When the next price poll goes out, and how much request weight is left.
+PollPlanner   poll_planner(poll_delay, POLL_IDLE_MAX_MS, PREFETCH_LEAD_MS);
+RequestBudget request_budget(REQUEST_WEIGHT_PER_MINUTE);
+
+/// Which batched request, if any, is waiting for its response.
+enum Fetch { FETCH_NONE, FETCH_OPENS, FETCH_PRICES, FETCH_AGGREGATE, FETCH_CHART };
+Fetch   fetching     = FETCH_NONE;
+
+/// The visible symbol and its prices when the request went out; the response
+/// is parsed over several ticks, so they are compared against these at the end.
+int           fetch_index      = 0;
+price_t       fetch_price      = 0;
+price_t       fetch_open       = 0;
+unsigned long fetch_parse_us   = 0;         ///< parse time of the response so far
+
+/// Candles of one symbol for the chart screen; one chart is shared by all symbols.
+CandleChart   chart;
+int           chart_index      = -1;        ///< symbol the candles belong to
+int           chart_requested  = -1;        ///< symbol of the klines request in flight
+unsigned long chart_fetched_ms = 0;
+bool          showing_chart    = false;     ///< the chart screen of symbol_index is up
+
+// ── Tasks ─────────────────────────────────────────────────────────────────────
+
+static void task_wifi();
+static void task_fetch();
+static void task_parse();
+static void task_warm();
+static void task_stream();
+static void task_rollover();
+static void task_rotate();
+static void task_render();
+static void task_animate();
+static void task_snapshot();
+static void task_metrics();
+
+enum { TASK_WIFI, TASK_FETCH, TASK_PARSE, TASK_WARM, TASK_STREAM, TASK_ROLLOVER,
+       TASK_ROTATE, TASK_RENDER, TASK_ANIMATE, TASK_SNAPSHOT, TASK_METRICS, TASK_COUNT };
+
+static Task tasks[TASK_COUNT] = {
+  { task_wifi,     500 },
+  { task_fetch,    (unsigned long)poll_delay },
+  { task_parse,    20 },
+  { task_warm,     0 },
+  { task_stream,   20 },
+  { task_rollover, 1000 },
+  { task_rotate,   SECONDS_TO_DISPLAY_EACH_SYMBOL * 1000UL },
+  { task_render,   50 },
+  { task_animate,  1000UL / ANIM_FPS },
+  { task_snapshot, BOOT_CACHE_SAVE_INTERVAL_MS },
+  { task_metrics,  250 },
+};
+
+/// Track WiFi state; start fetching when it comes up, stop when it drops.
+static void task_wifi() {
+  bool connected = WiFi.status() == WL_CONNECTED;
+  if (connected == wifi_up) {
+    if (connected) return;
     Serial.print('.');
+    if (wifi_fast_connect && millis() - wifi_started_ms >= WIFI_FAST_CONNECT_TIMEOUT_MS) {
+      Serial.println(F("Cached access point not answering, scanning"));
+      wifi_fast_connect = false;
+      wifi_begin(nullptr);
+    }
+    return;
   }
-  Serial.print(F("Connected! IP: "));
-  Serial.println(WiFi.localIP());
-  display.clearDisplay();
-  display.println(F("WiFi connected!"));
-  display.display();
+  wifi_up = connected;
 
-  // Fetch initial prices for all configured symbols
-  for (int i = 0; i < size_of_list_of_symbols; i++) {
-    closing_prices[i] = get_closing_price(list_of_symbols[i]);
-    current_prices[i] = get_current_price(list_of_symbols[i]);
+  if (connected) {
+    wifi_fast_connect = false;
+    Serial.print(F("Connected! IP: "));
+    Serial.println(WiFi.localIP());
+    if (!have_prices) screen.message(F("WiFi connected!"));
+    task_start(tasks[TASK_FETCH]);
+  } else {
+    Serial.println(F("WiFi connection lost"));
+    task_stop(tasks[TASK_FETCH]);
+    task_stop(tasks[TASK_PARSE]);
+    task_stop(tasks[TASK_WARM]);
+    task_stop(tasks[TASK_STREAM]);
+    conn_close();
+    price_stream_close();
+    aggregator_close();
+    fetching = FETCH_NONE;
   }
+}
 
-  // Show the first symbol immediately
-  print_to_screen(display,
-                  current_prices[0], current_prices[0],
-                  closing_prices[0], list_of_symbols[0]);
+/// Time until task_rotate() next runs, for the poll planner.
+static unsigned long until_rotate() {
+  const Task& rotate = tasks[TASK_ROTATE];
+  if (size_of_list_of_symbols < 2 || !rotate.enabled) return POLL_NO_ROTATION;
+  long left = (long)(rotate.next_run - millis());
+  return (left > 0) ? left : 0;
+}
 
-  start_time = millis();
+/// The visible symbol's candles are missing or older than CHART_REFRESH_MS.
+static bool chart_due() {
+  // Fresh prices first; the candles never replace the chart while it is on screen
+  if (!CHARTING || !have_prices || prices_stale || showing_chart) return false;
+  return chart_index != symbol_index || millis() - chart_fetched_ms >= CHART_REFRESH_MS;
 }
 
-// ─────────────────────────────────────────────────────────────────────────────
+/// Send the next batched request unless one is still outstanding.
+static void task_fetch() {
+  if (fetching != FETCH_NONE) return;
+  fetch_index    = symbol_index;
+  fetch_price    = current_prices[symbol_index];
+  fetch_open     = closing_prices[symbol_index];
+  fetch_parse_us = 0;
 
-void loop() {
-  if (WiFi.status() != WL_CONNECTED) return;
+  // The aggregator answers from memory: no exchange weight to budget for
+  if (USE_AGGREGATOR) {
+    if (aggregator_request()) {
+      fetching = FETCH_AGGREGATE;
+      task_start(tasks[TASK_PARSE]);
+    }
+    return;
+  }
 
-  long now = millis();
+  bool opens = !have_opens;
+  if (!opens && STREAMING) return;
+  bool candles = !opens && chart_due();
 
-  // Rotate to the next symbol once the display interval has elapsed
-  if (now > start_time + (SECONDS_TO_DISPLAY_EACH_SYMBOL * 1000L)) {
-    start_time   = now;
-    symbol_index = (symbol_index + 1) % size_of_list_of_symbols;
+  // Over budget: come back exactly when enough weight has refilled
+  uint16_t      weight = opens   ? closing_prices_weight()
+                       : candles ? klines_weight()
+                       :           current_prices_weight();
+  unsigned long now    = millis();
+  if (!request_budget.try_spend(weight, now)) {
+    task_start(tasks[TASK_FETCH], request_budget.wait_ms(weight, now));
+    return;
   }
 
-  double new_price = get_current_price(list_of_symbols[symbol_index]);
+  if (opens) {
+    if (request_closing_prices()) fetching = FETCH_OPENS;
+  } else if (candles) {
+    chart_requested = symbol_index;
+    if (request_klines(list_of_symbols[symbol_index])) fetching = FETCH_CHART;
+  } else {
+    if (request_current_prices()) fetching = FETCH_PRICES;
+  }
+  if (fetching != FETCH_NONE) task_start(tasks[TASK_PARSE]);
+}
 
+/// New prices landed (REST or stream): start rotating, redraw if visible changed.
+static void on_prices_updated() {
+  // Only ticks go into the history: a poll that repeats a price adds nothing
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    if (!price_history[i].is_newest(current_prices[i])) price_history[i].push(current_prices[i]);
+  }
+  if (!have_prices) {
+    have_prices = true;
+    task_start(tasks[TASK_ROTATE], tasks[TASK_ROTATE].period_ms);
+  }
+  if (prices_stale) {
+    prices_stale = false;
+    screen_dirty = true;                    // drop the "cached" tag
+  }
+  if (BOOT_CACHE && !tasks[TASK_SNAPSHOT].enabled) task_start(tasks[TASK_SNAPSHOT]);
   // Only redraw when the price has actually changed (avoids flicker)
-  if (new_price > 0 && new_price != current_prices[symbol_index]) {
-    print_to_screen(display,
-                    new_price,
-                    current_prices[symbol_index],
-                    closing_prices[symbol_index],
-                    list_of_symbols[symbol_index]);
-    current_prices[symbol_index] = new_price;
+  if (!showing_chart && current_prices[symbol_index] != shown_price) screen_dirty = true;
+}
+
+/// Poll the in-flight request; parse and publish the prices once it lands.
+static void task_parse() {
+  uint32_t agg_epoch = 0;
+
+  unsigned long parse_start = micros();
+  DEBUG_PHASE_BEGIN(parse);
+  int result;
+  if (fetching == FETCH_AGGREGATE) {
+    result = aggregator_poll(current_prices, closing_prices, &agg_epoch);
+  } else if (fetching == FETCH_OPENS) {
+    result = poll_closing_prices(closing_prices);
+  } else if (fetching == FETCH_CHART) {
+    result = poll_klines(chart);
+  } else {
+    result = poll_current_prices(current_prices);
+  }
+  fetch_parse_us += micros() - parse_start;
+  if (result == API_PENDING) return;
+  DEBUG_PHASE_END(parse);
+  metrics_record(PHASE_PARSE, fetch_parse_us);
+
+  const ConnServerTime& server = conn_server_time();
+  if (agg_epoch != 0) {
+    utc_clock.sync(agg_epoch, millis());
+  } else if (server.epoch != 0) {
+    utc_clock.sync(server.epoch, server.received_ms);
+  }
+
+  task_stop(tasks[TASK_PARSE]);
+  Fetch done = fetching;
+  fetching   = FETCH_NONE;
+  // If the server closed the socket, reconnect once the new prices are drawn
+  // rather than at the start of the next poll
+  if (done != FETCH_AGGREGATE && !STREAMING) {
+    task_start(tasks[TASK_WARM], tasks[TASK_RENDER].period_ms);
+  }
+  if (done == FETCH_CHART) {
+    // Empty on failure, so it is skipped; retried after CHART_REFRESH_MS
+    chart_index      = chart_requested;
+    chart_fetched_ms = millis();
+    task_start(tasks[TASK_FETCH]);          // this poll slot went to the candles
+    return;
+  }
+  if (result <= 0) return;                  // already logged; retried next tick
+
+  if (done == FETCH_OPENS) {
+    have_opens   = true;
+    screen_dirty = true;                    // the % change is against the new opens
+    opens_day.mark(utc_clock, millis());
+    if (STREAMING) {
+      // Prices now come from the stream; free the REST TLS context
+      task_stop(tasks[TASK_FETCH]);
+      conn_close();
+      task_start(tasks[TASK_STREAM]);
+    } else {
+      task_start(tasks[TASK_FETCH]);        // prices right away, not in poll_delay
+    }
+  } else {
+    if (done == FETCH_AGGREGATE) {
+      // Every frame carries the current opens, already rolled over upstream
+      have_opens = true;
+      if (closing_prices[fetch_index] != fetch_open) screen_dirty = true;
+    }
+    poll_planner.on_prices(current_prices[fetch_index] != fetch_price);
+    task_start(tasks[TASK_FETCH], poll_planner.next_delay(until_rotate()));
+    on_prices_updated();
+  }
+}
+
+/// One-shot: reopen the REST connection between polls if it was dropped.
+static void task_warm() {
+  task_stop(tasks[TASK_WARM]);
+  if (fetching == FETCH_NONE) conn_warm();
+}
+
+/// Streaming mode: consume whatever miniTicker frames have arrived.
+static void task_stream() {
+  int changed = price_stream_poll(current_prices,
+                                  STREAM_ROLLING_24H_OPEN ? closing_prices : nullptr);
+  if (changed > 0) on_prices_updated();
+}
+
+/// A new UTC day started: the daily opens moved, refetch them all in one request.
+static void task_rollover() {
+  if (USE_AGGREGATOR) return;               // the aggregator rolls the opens over
+  if (!wifi_up || !have_opens || !opens_day.due(utc_clock, millis())) return;
+  if (STREAMING && STREAM_ROLLING_24H_OPEN) return;   // stream owns the opens
+
+  Serial.println(F("New UTC day, refreshing daily opens"));
+  have_opens = false;
+  if (STREAMING) {
+    // Keep a single TLS context: pause the stream until the opens are in
+    task_stop(tasks[TASK_STREAM]);
+    price_stream_close();
+  }
+  task_start(tasks[TASK_FETCH]);
+}
+
+/// Advance to the next symbol (or its chart); its price is already fresh from the batch.
+static void task_rotate() {
+  // Not while candles are being read into the chart: it would show half-filled
+  if (CHARTING && !showing_chart && chart_index == symbol_index && chart.size() > 0
+      && fetching != FETCH_CHART) {
+    showing_chart = true;
+    screen_dirty  = true;
+    return;
+  }
+  showing_chart = false;
+  symbol_index  = (symbol_index + 1) % size_of_list_of_symbols;
+  screen_dirty  = true;
+
+  // The newly visible symbol is polled at full rate, even if the last one was idle
+  poll_planner.on_rotate();
+  if (have_opens && !STREAMING && fetching == FETCH_NONE
+      && tasks[TASK_FETCH].enabled) {
+    task_start(tasks[TASK_FETCH], poll_planner.next_delay(until_rotate()));
+  }
+}
+
+/// Log a boot milestone with the time since reset.
+static void report_boot_milestone(const __FlashStringHelper* what) {
+  Serial.print(F("[boot] "));
+  Serial.print(what);
+  Serial.print(F(": "));
+  Serial.print(millis());
+  Serial.println(F(" ms"));
+}
+
+static void task_render() {
+  if (!screen_dirty) return;
+  screen_dirty = false;
+
+  if (showing_chart) {
+    unsigned long render_start = micros();
+    screen.chart({&chart, list_of_symbols[symbol_index]});
+    metrics_record(PHASE_RENDER, micros() - render_start);
+    shown_index = -1;                       // no previous tick for the next price screen
+    return;
   }
 
-  delay(poll_delay);
+  price_t price = current_prices[symbol_index];
+  if (price <= 0) return;
+
+  price_t previous = (shown_index == symbol_index) ? shown_price : price;
+  unsigned long render_start = micros();
+  DEBUG_PHASE_BEGIN(render);
+  screen.show({price,
+               previous,
+               closing_prices[symbol_index],
+               list_of_symbols[symbol_index],
+               prices_stale,
+               &price_history[symbol_index]});
+  DEBUG_PHASE_END(render);
+  metrics_record(PHASE_RENDER, micros() - render_start);
+  shown_index = symbol_index;
+  shown_price = price;
+
+  if (!shown_first) {
+    shown_first = true;
+    report_boot_milestone(prices_stale ? F("first frame (cached)") : F("first frame"));
+  }
+  if (!shown_fresh && !prices_stale) {
+    shown_fresh = true;
+    report_boot_milestone(F("first fresh frame"));
+  }
+}
+
+/// Draw the next frame of a price tick transition, if one is running.
+static void task_animate() {
+  unsigned long now         = millis();
+  unsigned long frame_start = micros();
+  if (!screen.animate(now)) {
+    last_frame_ms = 0;
+    return;
+  }
+  unsigned long took_us = micros() - frame_start;
+  metrics_record(PHASE_FRAME, took_us);
+  metrics_count(COUNTER_FRAMES_DRAWN);
+
+  // Frames show the transition at the current time, so missed ones are just
+  // counted: a blocking parse or a slow flush never delays the network tasks
+  unsigned long period = tasks[TASK_ANIMATE].period_ms;
+  if (last_frame_ms != 0 && now - last_frame_ms >= 2 * period) {
+    metrics_count(COUNTER_FRAMES_DROPPED, (now - last_frame_ms) / period - 1);
+  }
+  last_frame_ms = now;
+
+  // A frame that overran its slot gives the other tasks the next one
+  if (took_us >= period * 1000UL) task_start(tasks[TASK_ANIMATE], period);
+}
+
+/// Sample heap gauges; answer the Serial "stats" command and /metrics scrapes.
+static void task_metrics() {
+  metrics_sample_heap();
+  metrics_poll();
+}
+
+/// Save prices, opens and WiFi details for the next warm boot.
+static void task_snapshot() {
+  if (!wifi_up) return;
+  boot_cache_save(current_prices, closing_prices,
+                  utc_clock.valid() ? utc_clock.now(millis()) : 0);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+
+void setup() {
+  Serial.begin(9600);
+
+  // Display init
+  Wire.begin(OLED_SDA, OLED_SCL);
+  delay(250);
+  screen.begin();
+
+  // Warm boot: show the last known prices while the network comes up
+  BootSnapshot snapshot;
+  bool cached = BOOT_CACHE && boot_cache_load(snapshot);
+  if (cached) {
+    memcpy(current_prices, snapshot.prices, sizeof(current_prices));
+    memcpy(closing_prices, snapshot.opens,  sizeof(closing_prices));
+    prices_stale = true;
+    screen_dirty = true;
+    have_prices  = true;
+    // REST mode polls prices straight away and keeps these opens unless the
+    // rollover task finds they are from an earlier UTC day
+    if (!STREAMING && snapshot.saved_epoch != 0) {
+      have_opens = true;
+      opens_day.mark_day(snapshot.saved_epoch / UTC_SECONDS_PER_DAY);
+    }
+  } else {
+    screen.message(F("Connecting..."));
+  }
+
+  // Built-in LED is active-low on most ESP8266 boards (HIGH = off)
+  pinMode(BUILTIN_LED, OUTPUT);
+  digitalWrite(BUILTIN_LED, HIGH);
+
+  // Wi-Fi: connection progress is tracked by task_wifi, not waited on here
+  wifi_begin(cached ? &snapshot : nullptr);
+  wifi_fast_connect = cached;
+  wifi_started_ms   = millis();
+
+  metrics_http_begin();
+
+  task_start(tasks[TASK_WIFI]);
+  task_start(tasks[TASK_METRICS]);
+  if (cached) task_start(tasks[TASK_ROTATE], tasks[TASK_ROTATE].period_ms);
+  task_start(tasks[TASK_ROLLOVER]);
+  task_start(tasks[TASK_RENDER]);
+  task_start(tasks[TASK_ANIMATE]);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+
+void loop() {
+  scheduler_run(tasks, TASK_COUNT);
 }
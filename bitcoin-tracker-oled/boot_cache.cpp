@@ -0,0 +1,95 @@
+/**
+ * @file boot_cache.cpp
+ * @brief LittleFS snapshot and WiFi fast-connect implementation.
+ */
+
+#include "boot_cache.h"
+
+#include <ESP8266WiFi.h>
+#include <LittleFS.h>
+
+#include "debug.h"
+#include "watchlist.h"
+
+#define SNAPSHOT_PATH     "/snapshot.bin"
+#define SNAPSHOT_TMP_PATH "/snapshot.tmp"
+#define SNAPSHOT_VERSION  1
+
+static bool mounted = false;
+
+/// Format version mixed with a hash of the watchlist, so a snapshot whose
+/// slots no longer line up with list_of_symbols[] is never loaded.
+static constexpr uint32_t SNAPSHOT_MAGIC = watchlist_hash(SNAPSHOT_VERSION);
+
+static bool mount() {
+  if (!mounted) {
+    mounted = LittleFS.begin();
+    if (!mounted) Serial.println(F("[cache] LittleFS mount failed"));
+  }
+  return mounted;
+}
+
+bool boot_cache_load(BootSnapshot& snap) {
+  if (!mount()) return false;
+
+  File file = LittleFS.open(SNAPSHOT_PATH, "r");
+  if (!file) return false;
+
+  bool ok = file.size() == sizeof(snap)
+         && file.read((uint8_t*)&snap, sizeof(snap)) == sizeof(snap)
+         && snap.magic == SNAPSHOT_MAGIC;
+  file.close();
+
+  if (!ok) Serial.println(F("[cache] snapshot ignored (other firmware or watchlist)"));
+  return ok;
+}
+
+bool boot_cache_save(const price_t* prices, const price_t* opens, uint32_t epoch) {
+  if (!mount()) return false;
+
+  BootSnapshot snap;
+  snap.magic       = SNAPSHOT_MAGIC;
+  snap.saved_epoch = epoch;
+  memcpy(snap.bssid, WiFi.BSSID(), sizeof(snap.bssid));
+  snap.channel     = WiFi.channel();
+  snap.ip          = WiFi.localIP();
+  snap.gateway     = WiFi.gatewayIP();
+  snap.subnet      = WiFi.subnetMask();
+  snap.dns         = WiFi.dnsIP();
+  memcpy(snap.prices, prices, sizeof(snap.prices));
+  memcpy(snap.opens,  opens,  sizeof(snap.opens));
+
+  File file = LittleFS.open(SNAPSHOT_TMP_PATH, "w");
+  if (!file) {
+    Serial.println(F("[cache] cannot write snapshot"));
+    return false;
+  }
+  bool ok = file.write((const uint8_t*)&snap, sizeof(snap)) == sizeof(snap);
+  file.close();
+
+  // rename() replaces the old snapshot atomically
+  if (!ok || !LittleFS.rename(SNAPSHOT_TMP_PATH, SNAPSHOT_PATH)) {
+    Serial.println(F("[cache] snapshot save failed"));
+    return false;
+  }
+  DEBUG_PRINT(F("[cache] snapshot saved"));
+  return true;
+}
+
+void wifi_begin(const BootSnapshot* snap) {
+  // The SDK would otherwise rewrite its own credential copy in flash on every begin()
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+
+  if (snap == nullptr) {
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());   // back to DHCP
+    WiFi.begin(ssid, password);
+    return;
+  }
+
+  if (BOOT_CACHE_STATIC_IP && snap->ip != 0) {
+    WiFi.config(IPAddress(snap->ip), IPAddress(snap->gateway),
+                IPAddress(snap->subnet), IPAddress(snap->dns));
+  }
+  WiFi.begin(ssid, password, snap->channel, snap->bssid);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file boot_cache.h
+ * @brief Warm-boot snapshot in LittleFS: last prices, daily opens and WiFi details.
+ *
+ * A cold boot used to show "Connecting..." until WiFi had scanned, DHCP had
+ * answered and both batched requests had completed.  With the snapshot the
+ * sketch instead:
+ *  - draws the last known prices immediately, marked as cached
+ *  - joins the last access point directly by BSSID and channel (no scan),
+ *    optionally on the last IP address (no DHCP)
+ *  - keeps the cached daily opens if they turn out to be from the current
+ *    UTC day, so the first fresh frame needs a single request
+ *
+ * The file is written to a temporary name and renamed into place, so a
+ * power cut during a save leaves the previous snapshot intact.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "config.h"
+#include "price.h"
+
+struct BootSnapshot {
+  uint32_t magic;                               ///< format version + watchlist fingerprint
+  uint32_t saved_epoch;                         ///< UTC seconds at save; 0 if the clock was not set
+  uint8_t  bssid[6];                            ///< access point last joined
+  int32_t  channel;
+  uint32_t ip, gateway, subnet, dns;            ///< last DHCP lease
+  price_t  prices[size_of_list_of_symbols];
+  price_t  opens[size_of_list_of_symbols];
+};
+
+/**
+ * @brief Mount LittleFS and read the snapshot.
+ * @return false if there is none, or it was written by another firmware
+ *         version or for a different @c list_of_symbols.
+ */
+bool boot_cache_load(BootSnapshot& snap);
+
+/**
+ * @brief Store @p prices, @p opens, @p epoch and the current WiFi details.
+ *
+ * Call only while WiFi is connected.  Each save is a flash write, so keep
+ * the rate low (see @c BOOT_CACHE_SAVE_INTERVAL_MS).
+ */
+bool boot_cache_save(const price_t* prices, const price_t* opens, uint32_t epoch);
+
+/**
+ * @brief Start connecting to WiFi, reusing the access point in @p snap.
+ *
+ * With @p snap == nullptr this is a plain WiFi.begin() with a scan and DHCP,
+ * which is also the fallback when the cached access point does not answer.
+ */
+void wifi_begin(const BootSnapshot* snap);
@@ -0,0 +1,110 @@
+/**
+ * @file candle_chart.cpp
+ * @brief Packed candle storage with a range grown while parsing.
+ */
+
+#include "candle_chart.h"
+
+/// (@p num + @p den / 2) / @p den, clamped to a valid level.
+static uint8_t round_level(int64_t num, int64_t den) {
+  int64_t v = (num + den / 2) / den;
+  if (v < 0)             return 0;
+  if (v > CANDLE_LEVELS) return CANDLE_LEVELS;
+  return (uint8_t)v;
+}
+
+/// Replace each of the four levels of @p c with @p fn(level).
+template <class Fn>
+static void remap(CandleChart::Candle& c, Fn fn) {
+  c.open  = fn(c.open);
+  c.high  = fn(c.high);
+  c.low   = fn(c.low);
+  c.close = fn(c.close);
+}
+
+uint8_t CandleChart::level(price_t price) const {
+  return round_level((price - lo_) * CANDLE_LEVELS, span_);
+}
+
+void CandleChart::rescale(price_t lo, price_t span) {
+  // A stored level b stands for lo_ + b × span_ / CANDLE_LEVELS; everything is
+  // kept multiplied by CANDLE_LEVELS so the only rounding is the final one
+  int64_t shift = (lo_ - lo) * CANDLE_LEVELS;
+  for (uint8_t i = 0; i < count_; i++) {
+    remap(candles_[(first_ + i) % CHART_CANDLES],
+          [&](uint8_t b) { return round_level(shift + b * span_, span); });
+  }
+  lo_   = lo;
+  span_ = span;
+}
+
+void CandleChart::clear() {
+  first_ = 0;
+  count_ = 0;
+  lo_    = 0;
+  span_  = 0;
+}
+
+void CandleChart::fit(price_t lo, price_t hi) {
+  // Headroom on both sides, so a trending market does not remap every candle
+  price_t pad = (hi - lo) / 4 + 1;
+  rescale(lo - pad, hi - lo + 2 * pad);
+}
+
+void CandleChart::shrink() {
+  uint8_t lowest  = CANDLE_LEVELS;
+  uint8_t highest = 0;
+  for (uint8_t i = 0; i < count_; i++) {
+    const Candle& c = candle(i);
+    if (c.low  < lowest)  lowest  = c.low;
+    if (c.high > highest) highest = c.high;
+  }
+  if (highest < lowest || 2 * (highest - lowest) >= CANDLE_LEVELS) return;
+
+  fit(lo_ + (int64_t)lowest  * span_ / CANDLE_LEVELS,
+      lo_ + (int64_t)highest * span_ / CANDLE_LEVELS);
+}
+
+void CandleChart::add(price_t open, price_t high, price_t low, price_t close) {
+  if (count_ == CHART_CANDLES) {
+    // Drop the oldest; the range it needed may be far wider than what is left
+    first_ = (first_ + 1) % CHART_CANDLES;
+    count_--;
+    shrink();
+  }
+
+  if (count_ == 0 || low < lo_ || high > lo_ + span_) {
+    price_t lo = (count_ > 0 && lo_ < low) ? lo_ : low;
+    price_t hi = (count_ > 0 && lo_ + span_ > high) ? lo_ + span_ : high;
+    fit(lo, hi);
+  }
+
+  Candle* c = &candles_[(first_ + count_) % CHART_CANDLES];
+  count_++;
+  c->open  = level(open);
+  c->high  = level(high);
+  c->low   = level(low);
+  c->close = level(close);
+}
+
+void CandleChart::finish() {
+  if (count_ == 0) return;
+
+  uint8_t lowest  = CANDLE_LEVELS;
+  uint8_t highest = 0;
+  for (uint8_t i = 0; i < count_; i++) {
+    const Candle& c = candle(i);
+    if (c.low  < lowest)  lowest  = c.low;
+    if (c.high > highest) highest = c.high;
+  }
+  if (highest == lowest) return;             // flat: nothing to stretch
+
+  // Not rescale(): the new range is expressed in the old levels
+  uint8_t range = highest - lowest;
+  for (uint8_t i = 0; i < count_; i++) {
+    remap(candles_[(first_ + i) % CHART_CANDLES],
+          [&](uint8_t b) { return round_level((int64_t)(b - lowest) * CANDLE_LEVELS, range); });
+  }
+  lo_  += (int64_t)lowest * span_ / CANDLE_LEVELS;
+  span_ = (int64_t)range  * span_ / CANDLE_LEVELS;
+}
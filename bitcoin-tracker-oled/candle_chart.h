@@ -0,0 +1,74 @@
+/**
+ * @file candle_chart.h
+ * @brief Recent candles of one symbol, packed to one byte per price.
+ *
+ * A klines response is several KB (~150 bytes per candle), far more than the
+ * chart needs: on a 54-px tall chart a price only has to be known to within
+ * a pixel.  Candles are therefore reduced as they are parsed, to four bytes
+ * each — open, high, low and close as levels 0–255 between lowest() and
+ * highest() — and the response itself is never held in memory.
+ *
+ * The range is not known until the last candle has been read, so it is
+ * grown while parsing: a candle outside the current range widens it (with a
+ * quarter of the span as headroom on each side, so this happens only a few
+ * times per response) and the stored levels are remapped onto the new
+ * range.  finish() then stretches the levels over the full 0–255.  Each
+ * remap rounds to the nearest level; test_klines checks that the candles
+ * still land within a pixel of their exact place.
+ *
+ * Only the newest @c CHART_CANDLES candles are kept: memory use is the same
+ * whatever @c limit the request asked for.  When dropping the oldest leaves
+ * the rest on less than half of the levels, the range shrinks to them, so a
+ * long response on a trending market is not squeezed into a few levels.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "config.h"
+#include "price.h"
+
+/// Levels of a stored price: 0 = lowest(), CANDLE_LEVELS = highest().
+#define CANDLE_LEVELS 255
+
+class CandleChart {
+ public:
+  /// One candle, each price as a level 0–CANDLE_LEVELS.
+  struct Candle {
+    uint8_t open;
+    uint8_t high;
+    uint8_t low;
+    uint8_t close;
+  };
+
+  /// Forget every candle.
+  void clear();
+
+  /// Append one candle; drops the oldest once @c CHART_CANDLES are held.
+  void add(price_t open, price_t high, price_t low, price_t close);
+
+  /// Stretch the levels so the lowest low is 0 and the highest high is CANDLE_LEVELS.
+  void finish();
+
+  /// Number of candles held.
+  uint8_t size() const { return count_; }
+
+  /// Candle @p i, oldest first.
+  const Candle& candle(uint8_t i) const { return candles_[(first_ + i) % CHART_CANDLES]; }
+
+  /// Prices of level 0 and CANDLE_LEVELS; only meaningful when size() > 0.
+  price_t lowest() const { return lo_; }
+  price_t highest() const { return lo_ + span_; }
+
+ private:
+  void rescale(price_t lo, price_t span);
+  void fit(price_t lo, price_t hi);
+  void shrink();
+  uint8_t level(price_t price) const;
+
+  Candle  candles_[CHART_CANDLES];
+  uint8_t first_ = 0;                  ///< oldest candle
+  uint8_t count_ = 0;
+  price_t lo_    = 0;                  ///< price of level 0
+  price_t span_  = 0;                  ///< price of level CANDLE_LEVELS, minus lo_
+};
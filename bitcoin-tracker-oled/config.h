@@ -20,12 +20,26 @@ static const char* const password = "wifi_pass_here";
 // ── Binance API ───────────────────────────────────────────────────────────────
 // Direct connection to Binance – no proxy needed.
 //
-// Endpoints used:
-//   Current price : GET /api/v3/ticker/price?symbol={SYMBOL}USDT
-//   Opening price : GET /api/v3/klines?symbol={SYMBOL}USDT&interval=1d&limit=1
-//                   → klines[0][1] = daily open = midnight UTC (same as OPENDAY)
+// Endpoints used, each one request for the whole watchlist:
+//   Current prices : GET /api/v3/ticker/price?symbols=["BTCUSDT","ETHUSDT"]
+//                    → weight 4, however many symbols are listed
+//   Opening prices : GET /api/v3/ticker/tradingDay?symbols=[...]&type=MINI
+//                    → openPrice = open at midnight UTC (same as OPENDAY);
+//                      weight 4 per symbol, capped at 200 past 50 symbols
+//   Candle chart   : GET /api/v3/klines?symbol={SYMBOL}USDT&interval=...
+//                    → weight 2, only with SHOW_CANDLE_CHART
 static const char* const BINANCE_HOST = "api.binance.com";
 
+// Equivalent Binance hosts, tried in turn whenever the current one does not
+// resolve or does not accept a connection.
+static const char* const BINANCE_FALLBACK_HOSTS[] = {
+  "api1.binance.com", "api2.binance.com", "api3.binance.com",
+};
+
+// How long a resolved API address is trusted before it is looked up again.
+// Keep it at or below the record's real TTL; lwIP honours that one itself.
+#define DNS_CACHE_TTL_MS 30000
+
 // TLS buffer sizes for BearSSL on ESP8266.
 // Larger buffers (1024/1024) are more reliable than smaller ones (512/512),
 // especially on slower WiFi or with higher network latency.
@@ -36,8 +50,10 @@ static const char* const BINANCE_HOST = "api.binance.com";
 
 // ── Symbols ───────────────────────────────────────────────────────────────────
 // Add/remove symbols as needed. Each must be a valid Binance base asset
-// traded against USDT (e.g. "BTC" → BTCUSDT).
-static const char* const list_of_symbols[] = {"BTC", "ETH"};
+// traded against USDT (e.g. "BTC" → BTCUSDT): upper case, at most 7
+// characters, listed once. The list is checked when compiling (watchlist.h),
+// and the request paths naming it are built into flash.
+static constexpr const char* list_of_symbols[] = {"BTC", "ETH"};
 
 // Seconds each symbol is shown on screen before rotating to the next one
 #define SECONDS_TO_DISPLAY_EACH_SYMBOL 10
@@ -46,19 +62,133 @@ static const char* const list_of_symbols[] = {"BTC", "ETH"};
 // true  → show percentage + absolute value change
 #define DIFF_PRINT_PERCENTAGE_AND_VALUE false
 
-// ── OLED ──────────────────────────────────────────────────────────────────────
+// ── Streaming (optional) ──────────────────────────────────────────────────────
+// false → prices are polled over REST every poll_delay ms (default)
+// true  → prices are pushed over one Binance WebSocket (<sym>usdt@miniTicker
+//         for every symbol). Fresher prices, no REST request weight; the daily
+//         open is still fetched over REST at boot and each UTC rollover.
+#define USE_WEBSOCKET_STREAM false
+
+static const char* const STREAM_HOST = "stream.binance.com";
+#define STREAM_PORT 9443
+
+// Streaming only: false → keep % change against the midnight-UTC open
+//                 true  → use miniTicker's rolling 24 h open instead
+#define STREAM_ROLLING_24H_OPEN false
+
+// ── LAN aggregator (optional) ─────────────────────────────────────────────────
+// true → fetch prices and daily opens from a tracker-aggregator on the local
+//        network (see aggregator/README.md) instead of from Binance. One
+//        aggregator polls the exchange for every tracker; each device speaks
+//        plain HTTP to it and never opens a TLS connection. Overrides
+//        USE_WEBSOCKET_STREAM.
+#define USE_AGGREGATOR false
+
+static const char* const AGGREGATOR_HOST = "192.168.1.10";
+#define AGGREGATOR_PORT 8080
+
+// ── Fast boot ─────────────────────────────────────────────────────────────────
+// true → keep the last prices and WiFi details in flash (LittleFS) and draw
+//        them, marked "cached", right at boot while the network comes up.
+//        Needs a flash layout with a filesystem (Tools → Flash Size).
+#define BOOT_CACHE true
+
+// Milliseconds between snapshot writes: freshness after a reboot vs flash wear
+#define BOOT_CACHE_SAVE_INTERVAL_MS 600000UL
+
+// true → also rejoin on the last DHCP address, skipping DHCP. Only safe when
+//        the router reserves that address for this device.
+#define BOOT_CACHE_STATIC_IP false
+
+// Fall back to a normal scan + DHCP if the cached access point has not let us
+// in after this many milliseconds (moved channel, replaced router, ...).
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 5000
+
+// ── Metrics ───────────────────────────────────────────────────────────────────
+// Timing histograms and heap gauges in Prometheus text format at
+// http://<device-ip>/metrics on this port (0 disables the listener).
+// Typing "stats" in the Serial Monitor prints the same data.
+#define METRICS_HTTP_PORT 80
+
+// ── Display ───────────────────────────────────────────────────────────────────
+// Pick the panel at compile time; everything except drawing is shared.
+#define DISPLAY_BACKEND_OLED 1   // SH1106G 128×64 OLED (Adafruit SH110X)
+#define DISPLAY_BACKEND_LCD  2   // 16×2 character LCD, I2C backpack (LiquidCrystal I2C)
+#define DISPLAY_BACKEND DISPLAY_BACKEND_OLED
+
+// I2C pins, used by either panel
 #define OLED_SDA      D1
 #define OLED_SCL      D2
-#define OLED_I2C_ADDR 0x3c
-#define OLED_WIDTH    128
-#define OLED_HEIGHT   64
-#define OLED_RESET    -1
+
+// ── OLED ──────────────────────────────────────────────────────────────────────
+#define OLED_I2C_ADDR  0x3c
+#define OLED_WIDTH     128
+#define OLED_HEIGHT    64
+#define OLED_RESET     -1
+#define OLED_I2C_CLOCK 400000   // I2C fast mode; 100000 for long or noisy wiring
+
+// ── LCD ───────────────────────────────────────────────────────────────────────
+#define LCD_I2C_ADDR  0x3F
+#define LCD_COLUMNS   16
+#define LCD_ROWS      2
+
+// ── Animation ─────────────────────────────────────────────────────────────────
+// On the OLED, a price tick rolls the changed digits into place (up on a
+// rise, down on a fall). When the tick reverses the direction of the last
+// one, the changed digits also flash inverted. Frames are timed from the
+// tick, so a frame missed during a slow network read is skipped, not queued.
+#define ANIMATE_PRICE_TICKS true
+#define ANIM_FPS            30
+#define ANIM_ROLL_MS        250   // digit roll duration
+#define ANIM_FLASH_MS       150   // inverted flash duration
+
+// ── Tick history ──────────────────────────────────────────────────────────────
+// Recent prices per symbol, drawn as a sparkline under the price (OLED only).
+// Each block holds ~30 ticks at 2 bytes each; the oldest block is dropped when
+// all are full. 8 × 64 bytes keeps ~250 ticks per symbol in ~600 bytes.
+#define SHOW_SPARKLINE           true
+#define TICK_HISTORY_BLOCKS      8
+#define TICK_HISTORY_BLOCK_BYTES 64
+
+// ── Candle chart ──────────────────────────────────────────────────────────────
+// After each symbol's price screen, the rotation shows its recent candles for
+// another SECONDS_TO_DISPLAY_EACH_SYMBOL. REST polling mode only (not with
+// USE_WEBSOCKET_STREAM or USE_AGGREGATOR). Each candle takes 4 bytes of RAM;
+// the klines response itself (~150 bytes per candle) is never buffered.
+#define SHOW_CANDLE_CHART true
+#define CHART_INTERVAL    "15m"   // Binance kline interval: 1m 5m 15m 1h 4h 1d ...
+#define CHART_CANDLES     64      // candles per chart, at most 128 (one per column)
+#define CHART_REFRESH_MS  60000   // refetch a symbol's candles when older than this
 
 // ── Polling ───────────────────────────────────────────────────────────────────
-// Poll delay in milliseconds. 5000 ms gives the TLS handshake time to complete
-// without stalling the display. Reduce only if your network is fast and stable.
-const int poll_delay = 5000;
+// Poll delay in milliseconds. The TLS connection is kept alive between polls
+// (see connection.h), so a poll is a single request/response round-trip and
+// sub-second intervals are fine. Increase on slow or metered networks.
+const int poll_delay = 1000;
+
+// Adaptive polling (REST mode only). poll_delay is the fastest rate, used
+// while the visible price is moving; each unchanged response doubles the
+// interval up to POLL_IDLE_MAX_MS. A poll is also pulled forward to land
+// PREFETCH_LEAD_MS before each rotation so the next symbol appears fresh.
+#define POLL_IDLE_MAX_MS  8000
+#define PREFETCH_LEAD_MS  1000
+
+// Binance request weight this device may spend per minute. The IP limit is
+// 6000; staying well below it leaves room for other devices on the same
+// connection. A batched price poll costs 4, the daily opens 4 per symbol.
+#define REQUEST_WEIGHT_PER_MINUTE 1200
+
+// ── Memory budget ─────────────────────────────────────────────────────────────
+// Checked when compiling (memory_budget.cpp): the RAM taken by the watchlist
+// state, the display and the TLS connections must fit RAM_BUDGET_BYTES, and
+// each request buffer built on the stack must fit REQUEST_STACK_BYTES. About
+// 40 KB of heap is free once WiFi is up; the rest is headroom for lwIP.
+// Type "memory" in the Serial Monitor for the breakdown.
+#define RAM_BUDGET_BYTES    32768
+#define REQUEST_STACK_BYTES 1024
 
 const int size_of_list_of_symbols = sizeof(list_of_symbols) / sizeof(list_of_symbols[0]);
+const int size_of_fallback_hosts  =
+    sizeof(BINANCE_FALLBACK_HOSTS) / sizeof(BINANCE_FALLBACK_HOSTS[0]);
 
 #endif // CONFIG_H
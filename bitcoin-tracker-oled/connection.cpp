@@ -0,0 +1,495 @@
+/**
+ * @file connection.cpp
+ * @brief Persistent keep-alive HTTPS connection implementation.
+ *
+ * Speaks a minimal subset of HTTP/1.1 directly over one long-lived
+ * WiFiClientSecure instead of going through HTTPClient, which tears the
+ * socket down on every end().  Only what the Binance REST API needs is
+ * handled: status line, Content-Length, chunked transfer encoding and
+ * @c Connection: close.
+ */
+
+#include "connection.h"
+
+#include <ESP8266WiFi.h>
+#include <WiFiClientSecure.h>
+
+#include "api_hosts.h"
+#include "config.h"
+#include "debug.h"
+#include "metrics.h"
+#include "utc_clock.h"
+
+// Longest response header line we care about; longer lines are truncated.
+#define CONN_HEADER_LINE    128
+
+#define CONN_PORT           443
+#define CONN_TIMEOUT_MS     5000
+
+// Bounds on connection setup.  A dead resolver or address costs at most this
+// long before the next fallback host is tried, instead of the core's 10 s
+// default or the handshake timeout.
+#define CONN_DNS_TIMEOUT_MS     1500
+#define CONN_CONNECT_TIMEOUT_MS 2000
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Response headers
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Status line and framing headers of one response, parsed as they arrive.
+ *
+ * Like BodyReader, takes whatever bytes have arrived and returns, so
+ * headers split across TLS records, or stalled half-way, never hold up the
+ * loop; the caller bounds how long they may take.
+ */
+class HeaderReader {
+ public:
+  void reset() {
+    line_len_    = 0;
+    status_read_ = false;
+    code_        = 0;
+    length_      = -1;
+    chunked_     = false;
+    keep_alive_  = false;
+    date_        = {0, 0};
+  }
+
+  /**
+   * @brief Consume the header bytes that have arrived.
+   * @param now_ms  millis(), recorded with the @c Date header.
+   * @return @c CONN_PENDING until the blank line ending the headers, then the
+   *         HTTP status; @c CONN_ERROR_BAD_RESPONSE or @c CONN_ERROR_LOST.
+   */
+  int read(Client& client, unsigned long now_ms) {
+    int c;
+    while ((c = client.read()) >= 0) {
+      if (c != '\n') {
+        // Longer lines are truncated; CRs are dropped
+        if (c != '\r' && line_len_ < sizeof(line_) - 1) line_[line_len_++] = (char)c;
+        continue;
+      }
+      line_[line_len_] = '\0';
+      int result = end_of_line(now_ms);
+      line_len_  = 0;
+      if (result != CONN_PENDING) return result;
+    }
+    return client.connected() ? CONN_PENDING : CONN_ERROR_LOST;
+  }
+
+  long                  length() const { return length_; }        ///< -1 if not given
+  bool                  chunked() const { return chunked_; }
+  bool                  keep_alive() const { return keep_alive_; }
+  const ConnServerTime& date() const { return date_; }           ///< epoch 0 if absent
+
+ private:
+  /// Act on the complete line in line_.
+  int end_of_line(unsigned long now_ms) {
+    if (!status_read_) {
+      if (strncmp_P(line_, PSTR("HTTP/1."), 7) != 0 || line_len_ < 12) {
+        return CONN_ERROR_BAD_RESPONSE;
+      }
+      code_ = atoi(line_ + 9);
+      if (code_ <= 0) return CONN_ERROR_BAD_RESPONSE;
+      keep_alive_  = line_[7] == '1';              // HTTP/1.1 defaults to keep-alive
+      status_read_ = true;
+    } else if (line_len_ == 0) {
+      return code_;                                // blank line: headers complete
+    } else if (strncasecmp_P(line_, PSTR("Content-Length:"), 15) == 0) {
+      length_ = atol(line_ + 15);
+    } else if (strncasecmp_P(line_, PSTR("Transfer-Encoding:"), 18) == 0) {
+      chunked_ = strstr_P(line_ + 18, PSTR("chunked")) != nullptr;
+    } else if (strncasecmp_P(line_, PSTR("Connection:"), 11) == 0) {
+      keep_alive_ = strstr_P(line_ + 11, PSTR("close")) == nullptr;
+    } else if (strncasecmp_P(line_, PSTR("Date:"), 5) == 0) {
+      uint32_t epoch;
+      if (http_date_parse(line_ + 5, &epoch)) date_ = {epoch, now_ms};
+    }
+    return CONN_PENDING;
+  }
+
+  char           line_[CONN_HEADER_LINE];
+  uint8_t        line_len_    = 0;
+  bool           status_read_ = false;
+  int            code_        = 0;
+  long           length_      = -1;
+  bool           chunked_     = false;
+  bool           keep_alive_  = false;
+  ConnServerTime date_        = {0, 0};
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Response body
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Reader that yields exactly the body of one response, without waiting.
+ *
+ * Stops at Content-Length, or decodes chunked framing on the fly, so parsers
+ * never read into the next response on the same socket.  The chunk framing
+ * is parsed one byte at a time like the data, so a chunk header split
+ * across TLS records costs nothing but another call.
+ */
+class BodyReader {
+ public:
+  void reset(Client* client, long length, bool chunked) {
+    client_    = client;
+    remaining_ = chunked ? 0 : length;
+    state_     = chunked ? CHUNK_SIZE : DATA;
+    chunked_   = chunked;
+    line_len_  = 0;
+    finished_  = client == nullptr || (!chunked && length == 0);
+    broken_    = false;
+  }
+
+  /// True once the last body byte (and chunk trailer) has been consumed.
+  bool finished() const { return finished_; }
+
+  /// True when the body was cut short or its chunk framing could not be parsed.
+  bool broken() const { return broken_; }
+
+  /// Give up on the rest of the body.
+  void abandon() { broken_ = finished_ = true; }
+
+  /// Next body byte, @c CONN_BODY_PENDING if none has arrived yet, or -1 at the end.
+  int read() {
+    while (!finished_) {
+      int c = client_->read();
+      if (c < 0) {
+        // Bodies without a length end when the server closes the socket;
+        // any other body closed early is truncated
+        if (!client_->connected()) {
+          if (state_ != DATA || remaining_ >= 0) broken_ = true;
+          finished_ = true;
+          break;
+        }
+        return CONN_BODY_PENDING;
+      }
+      if (state_ == DATA) {
+        if (remaining_ > 0 && --remaining_ == 0) {
+          if (chunked_) state_ = CHUNK_END;
+          else          finished_ = true;
+        }
+        return c;
+      }
+      frame_byte((char)c);
+    }
+    return -1;
+  }
+
+ private:
+  enum State : uint8_t {
+    DATA,           ///< body bytes; remaining_ of them, or until close if -1
+    CHUNK_SIZE,     ///< "<hex-size>[;ext]\r\n"
+    CHUNK_END,      ///< the "\r\n" after a chunk's data
+    TRAILER,        ///< header lines after the last chunk, up to a blank one
+  };
+
+  /// Consume one byte of chunk framing.
+  void frame_byte(char c) {
+    if (c == '\r') return;
+    bool end_of_line = (c == '\n');
+    switch (state_) {
+      case CHUNK_SIZE:
+        if (end_of_line) {
+          state_ = (remaining_ > 0) ? DATA : TRAILER;
+        } else if (line_len_ == 0 && isxdigit((unsigned char)c)) {
+          if (remaining_ >= 0x1000000L) {
+            abandon();                       // no API response has 16 MB chunks
+            return;
+          }
+          remaining_ = remaining_ * 16 + (isdigit((unsigned char)c) ? c - '0'
+                                                                    : (c | 0x20) - 'a' + 10);
+        } else {
+          line_len_ = 1;                     // chunk extension: ignored
+        }
+        if (end_of_line) line_len_ = 0;
+        break;
+      case CHUNK_END:
+        if (end_of_line) state_ = CHUNK_SIZE;
+        break;
+      case TRAILER:
+        if (end_of_line && line_len_ == 0) finished_ = true;
+        line_len_ = end_of_line ? 0 : 1;
+        break;
+      case DATA:
+        break;
+    }
+  }
+
+  Client* client_    = nullptr;
+  long    remaining_ = 0;        ///< bytes left in body/chunk; -1 = until close
+  State   state_     = DATA;
+  bool    chunked_   = false;
+  uint8_t line_len_  = 0;        ///< non-zero once a framing line has other content
+  bool    finished_  = true;
+  bool    broken_    = false;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Connection state
+// ─────────────────────────────────────────────────────────────────────────────
+
+static WiFiClientSecure client;
+static BearSSL::Session session;    // enables abbreviated handshakes on reconnect
+static HeaderReader     headers;
+static BodyReader       body;
+static ConnTiming       timing;
+static ConnServerTime   server_time   = {0, 0};
+static bool             configured    = false;
+static bool             keep_alive    = false;
+static bool             in_flight     = false;
+static bool             in_headers    = false;    // response has started arriving
+static bool             retried       = false;
+static unsigned long    request_start = 0;
+static unsigned long    request_start_us = 0;
+static unsigned long    headers_start = 0;
+static unsigned long    body_start    = 0;
+static ApiHosts         hosts(BINANCE_HOST, BINANCE_FALLBACK_HOSTS, size_of_fallback_hosts,
+                              DNS_CACHE_TTL_MS);
+
+// The request is kept until its response arrives so that it can be re-sent
+// if a reused socket turns out to have been closed by the server.
+static char request[CONN_REQUEST_BUFFER];
+static int  request_len = 0;
+
+/**
+ * @brief Look up the current API host, waiting at most CONN_DNS_TIMEOUT_MS.
+ *
+ * Resolved separately from connect() so that DNS shows up on its own in the
+ * metrics and a slow resolver fails fast; connect() would otherwise wait up
+ * to the core's 10 s default.  The address is kept for DNS_CACHE_TTL_MS
+ * (api_hosts.h), and connect() gets it from lwIP's table.
+ */
+static bool resolve_host() {
+  unsigned long start_us = micros();
+  IPAddress     ip;
+  if (!WiFi.hostByName(hosts.host(), ip, CONN_DNS_TIMEOUT_MS)) {
+    Serial.print(F("[conn] DNS lookup failed: "));
+    Serial.println(hosts.host());
+    hosts.fail();
+    return false;
+  }
+  metrics_record(PHASE_DNS, micros() - start_us);
+  hosts.store(ip, millis());
+  return true;
+}
+
+/**
+ * @brief Plain TCP connect to the address of the current host, closed at once.
+ *
+ * BearSSL bounds the TCP connect and the handshake with one timeout, which
+ * has to leave room for a slow handshake.  This probe gives the TCP connect
+ * alone CONN_CONNECT_TIMEOUT_MS, so an address that accepts nothing is
+ * given up on in that time; a live one costs an extra round-trip.
+ */
+static bool probe_address() {
+  WiFiClient probe;
+  probe.setTimeout(CONN_CONNECT_TIMEOUT_MS);
+  bool ok = probe.connect(hosts.address(), CONN_PORT);
+  probe.stop();
+  return ok;
+}
+
+/**
+ * @brief Open a fresh TLS connection to the current API host (api_hosts.h).
+ *
+ * TLS settings are applied once: they persist on the client object across
+ * reconnects.  Certificate verification is disabled (setInsecure) — the same
+ * trade-off as before, acceptable for non-safety-critical price data.
+ */
+static bool open_connection() {
+  if (!configured) {
+    client.setInsecure();
+    client.setBufferSizes(TLS_READ_BUFFER, TLS_WRITE_BUFFER);
+    client.setSession(&session);
+    client.setTimeout(CONN_TIMEOUT_MS);
+    configured = true;
+  }
+
+  if (!hosts.fresh(millis()) && !resolve_host()) return false;
+
+  unsigned long start    = millis();
+  unsigned long start_us = micros();
+
+  // The host name (not the cached IP) is passed to connect() because TLS
+  // needs it for SNI.  Its timeout stays at CONN_TIMEOUT_MS so that a slow
+  // but healthy handshake completes; the probe has already failed fast on
+  // a dead address.
+  bool ok = probe_address() && client.connect(hosts.host(), CONN_PORT);
+  timing.handshake_ms = millis() - start;
+  if (ok) metrics_record(PHASE_CONNECT, micros() - start_us);
+
+  if (!ok) {
+    Serial.print(F("[conn] connect to "));
+    Serial.print(hosts.host());
+    Serial.print(F(" failed after "));
+    Serial.print(timing.handshake_ms);
+    Serial.println(F(" ms"));
+    hosts.fail();
+  } else {
+    DEBUG_PRINT(timing.handshake_ms);
+  }
+  return ok;
+}
+
+/// Take over the framing the headers announced and start reading the body.
+static void start_body() {
+  if (headers.date().epoch != 0) server_time = headers.date();
+
+  // Without framing information the body only ends when the socket closes
+  keep_alive = headers.keep_alive() && (headers.chunked() || headers.length() >= 0);
+
+  body.reset(&client, headers.length(), headers.chunked());
+  body_start = millis();
+}
+
+/**
+ * @brief Write the stored request, opening the connection first if needed.
+ *
+ * The TLS handshake itself is synchronous (BearSSL on ESP8266 has no
+ * non-blocking connect), but with keep-alive it only happens on reconnects.
+ */
+static int send_request() {
+  timing.reused = client.connected();
+  if (!timing.reused && !open_connection()) return CONN_ERROR_CONNECT;
+
+  request_start    = millis();
+  request_start_us = micros();
+  if (client.write((const uint8_t*)request, request_len) != (size_t)request_len) {
+    client.stop();
+    if (timing.reused && !retried) {
+      retried = true;
+      return send_request();
+    }
+    return CONN_ERROR_SEND;
+  }
+
+  headers.reset();
+  in_headers = false;
+  in_flight  = true;
+  return 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Public API
+// ─────────────────────────────────────────────────────────────────────────────
+
+int conn_send(const char* path) {
+  request_len = snprintf_P(request, sizeof(request),
+                           PSTR("GET %s HTTP/1.1\r\n"
+                                "Host: %s\r\n"
+                                "User-Agent: esp8266-bitcoin-tracker\r\n"
+                                "Connection: keep-alive\r\n"
+                                "\r\n"),
+                           path, hosts.host());
+  if (request_len < 0 || request_len >= (int)sizeof(request)) {
+    return CONN_ERROR_TOO_LONG;
+  }
+
+  body.reset(nullptr, 0, false);
+  timing.handshake_ms = 0;
+  retried             = false;
+  return send_request();
+}
+
+int conn_poll() {
+  if (!in_flight) return CONN_ERROR_SEND;
+
+  if (!in_headers && client.available() > 0) {
+    // The response has started arriving: from here on the headers are
+    // parsed as far as they have got, and have CONN_TIMEOUT_MS to finish
+    metrics_record(PHASE_TTFB, micros() - request_start_us);
+    in_headers    = true;
+    headers_start = millis();
+  }
+
+  int code;
+  if (in_headers) {
+    code = headers.read(client, millis());
+    if (code > 0) {
+      in_flight = false;
+      start_body();
+      return code;
+    }
+    if (code == CONN_PENDING) {
+      if (millis() - headers_start < CONN_TIMEOUT_MS) return CONN_PENDING;
+      Serial.println(F("[conn] response headers timed out"));
+      code = CONN_ERROR_TIMEOUT;
+    }
+  } else if (!client.connected()) {
+    code = CONN_ERROR_LOST;
+  } else if (millis() - request_start >= CONN_TIMEOUT_MS) {
+    code = CONN_ERROR_TIMEOUT;
+  } else {
+    return CONN_PENDING;
+  }
+
+  in_flight = false;
+  client.stop();
+
+  // A reused socket may have been closed by the server while idle; in that
+  // case retry exactly once on a freshly opened connection.
+  if (timing.reused && !retried) {
+    retried = true;
+    int err = send_request();
+    return (err < 0) ? err : CONN_PENDING;
+  }
+  // A fresh connection that did not answer: try another host next time
+  hosts.fail();
+  return code;
+}
+
+int conn_body_read() {
+  int c = body.read();
+  if (c == CONN_BODY_PENDING && millis() - body_start >= CONN_BODY_TIMEOUT_MS) {
+    Serial.println(F("[conn] response body timed out"));
+    body.abandon();
+    return -1;
+  }
+  return c;
+}
+
+void conn_end() {
+  in_flight = false;   // abandoning a pending request also ends it
+
+  // Skip what has arrived of the unread body; if more is still on its way
+  // the socket is closed below instead of waited on
+  while (body.read() >= 0) {}
+
+  if (!keep_alive || !body.finished() || body.broken()) {
+    client.stop();
+  }
+  timing.request_ms = millis() - request_start;
+  body.reset(nullptr, 0, false);
+}
+
+void conn_warm() {
+  if (in_flight || client.connected()) return;
+  open_connection();
+}
+
+void conn_close() {
+  in_flight = false;
+  client.stop();
+}
+
+const ConnTiming& conn_last_timing() {
+  return timing;
+}
+
+const ConnServerTime& conn_server_time() {
+  return server_time;
+}
+
+const __FlashStringHelper* conn_error_to_string(int code) {
+  switch (code) {
+    case CONN_ERROR_CONNECT:      return F("connect/handshake failed");
+    case CONN_ERROR_SEND:         return F("send failed");
+    case CONN_ERROR_LOST:         return F("connection lost");
+    case CONN_ERROR_TIMEOUT:      return F("read timeout");
+    case CONN_ERROR_BAD_RESPONSE: return F("bad response");
+    case CONN_ERROR_TOO_LONG:     return F("request too long");
+    default:                      return F("unexpected status");
+  }
+}
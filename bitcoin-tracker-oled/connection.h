@@ -0,0 +1,141 @@
+/**
+ * @file connection.h
+ * @brief Persistent keep-alive HTTPS connection to the Binance REST API.
+ *
+ * A single WiFiClientSecure socket to the Binance API is kept open across
+ * requests, so a poll normally costs one request/response round-trip instead
+ * of a full TLS handshake.  When the socket has been dropped (idle timeout,
+ * WiFi blip) it is reopened with the cached BearSSL session, which lets the
+ * server accept an abbreviated handshake.  When @c BINANCE_HOST does not
+ * resolve or answer, the fallback hosts from config.h are tried in turn
+ * (api_hosts.h).
+ *
+ * Only one request can be in flight at a time.  Nothing waits on the
+ * server: the caller sends, then keeps polling from a scheduler task while
+ * the response arrives, and parses the body as far as it has got:
+ * @code
+ * conn_send("/api/v3/ping");
+ * // ... later, from a scheduler task:
+ * int code = conn_poll();
+ * if (code == CONN_PENDING) return;   // try again on the next tick
+ * // ... then, on this and later ticks:
+ * int c;
+ * while ((c = conn_body_read()) >= 0) parser.feed(c);
+ * if (c == CONN_BODY_PENDING) return;  // more of the body is on its way
+ * conn_end();                          // always, even on error
+ * @endcode
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/// conn_poll() result while the response has not started arriving yet.
+#define CONN_PENDING 0
+
+/// conn_body_read() result while the next body byte has not arrived yet.
+#define CONN_BODY_PENDING -2
+
+/// Longest a response body may take to arrive in full, counted from its headers.
+#define CONN_BODY_TIMEOUT_MS 10000
+
+/// Bytes of the request buffer: "GET <path> HTTP/1.1" plus headers.
+#define CONN_REQUEST_BUFFER  512
+
+/// Part of the request buffer taken by everything but the path, for the
+/// longest API host name.
+#define CONN_REQUEST_HEADERS 112
+
+// Negative return codes of conn_poll(); positive values are HTTP status codes.
+// Values mirror HTTPClient's HTTPC_ERROR_* codes where the meaning matches,
+// so the troubleshooting notes in the README still apply.
+#define CONN_ERROR_CONNECT      -1   ///< TCP connect or TLS handshake failed
+#define CONN_ERROR_SEND         -2   ///< request could not be written
+#define CONN_ERROR_LOST         -5   ///< socket closed while reading headers
+#define CONN_ERROR_BAD_RESPONSE -7   ///< status line could not be parsed
+#define CONN_ERROR_TIMEOUT      -11  ///< no complete headers within the timeout
+#define CONN_ERROR_TOO_LONG     -12  ///< request path exceeds the request buffer
+
+/// Latency breakdown of the most recent request.
+struct ConnTiming {
+  unsigned long handshake_ms;   ///< TCP + TLS setup; 0 when the socket was reused
+  unsigned long request_ms;     ///< request sent → response body fully consumed
+  bool          reused;         ///< true when an already-open socket was used
+};
+
+/// Server clock reported by the @c Date header of the most recent response.
+struct ConnServerTime {
+  uint32_t      epoch;          ///< UTC seconds; 0 until a response carried a Date
+  unsigned long received_ms;    ///< millis() when that header was read
+};
+
+/**
+ * @brief Start a GET request for @p path without waiting for the response.
+ *
+ * Opens (or reuses) the connection to the current API host.  Only a
+ * reconnect (TLS handshake) blocks; on a kept-alive socket this just writes
+ * the request.  Follow up with conn_poll().
+ *
+ * @param path  Request target, e.g. "/api/v3/ticker/price?symbols=...".
+ * @return 0 when the request was sent, or a negative @c CONN_ERROR_* code.
+ */
+int conn_send(const char* path);
+
+/**
+ * @brief Check on the request started by conn_send().
+ *
+ * Returns immediately.  Once the first response bytes are available the
+ * headers are parsed as far as they have arrived, and when they are
+ * complete the HTTP status is returned; conn_body_read() is then ready.
+ * If a reused socket turns out to have been closed by the server, the
+ * request is re-sent once on a fresh connection.  Gives up with
+ * @c CONN_ERROR_TIMEOUT if nothing arrives in time, or if the headers stop
+ * arriving part-way.
+ *
+ * @return @c CONN_PENDING, an HTTP status code, or a negative @c CONN_ERROR_* code.
+ */
+int conn_poll();
+
+/**
+ * @brief Read the next byte of the current response body, without waiting.
+ *
+ * Chunked transfer encoding is decoded on the way, and reads stop at the
+ * end of the body, so the bytes can be fed straight to a parser.  A body
+ * that has not fully arrived within @c CONN_BODY_TIMEOUT_MS of its headers
+ * is cut off: the next read returns -1 and conn_end() closes the socket.
+ *
+ * @return The byte (0–255), @c CONN_BODY_PENDING while the next byte has not
+ *         arrived yet, or -1 at the end of the body (or when it was cut off).
+ */
+int conn_body_read();
+
+/**
+ * @brief Finish the current response.
+ *
+ * Skips body bytes that have already arrived but were not read.  The socket
+ * is kept for the next request only if the body was read to its end and the
+ * server did not ask to close it; otherwise it is closed rather than waited
+ * on.  Must be called after every conn_send(), whatever the outcome.
+ */
+void conn_end();
+
+/**
+ * @brief Reopen the connection ahead of the next request if it is down.
+ *
+ * Does nothing while a request is in flight or the socket is open.  The
+ * DNS lookup and TLS handshake still block, so call this from its own task
+ * right after a response has been handled: the next request then finds an
+ * open socket and costs a single round-trip.
+ */
+void conn_warm();
+
+/// Close the connection (the TLS session is kept for fast resumption).
+void conn_close();
+
+/// Timing of the most recent request; valid after conn_end().
+const ConnTiming& conn_last_timing();
+
+/// Date of the most recent response that had one (for UtcClock::sync()).
+const ConnServerTime& conn_server_time();
+
+/// Short human-readable description of a negative @c CONN_ERROR_* code.
+const __FlashStringHelper* conn_error_to_string(int code);
@@ -5,7 +5,12 @@
  * To enable verbose Serial output, either uncomment the #define below or add
  * -DDEBUG to your build flags before flashing.
  *
- * When DEBUG is not defined the macro expands to nothing, so there is zero
+ * DEBUG_PHASE_BEGIN / DEBUG_PHASE_END bracket one phase of a poll cycle
+ * (parse, render, …) and print its duration in microseconds together with
+ * the free heap, giving a repeatable per-phase number to compare changes
+ * against on real hardware.
+ *
+ * When DEBUG is not defined the macros expand to nothing, so there is zero
  * runtime and flash overhead in release builds.
  */
 #pragma once
@@ -14,6 +19,12 @@
 
 #ifdef DEBUG
   #define DEBUG_PRINT(x) Serial.println(x)
+  #define DEBUG_PHASE_BEGIN(name) unsigned long _phase_##name = micros()
+  #define DEBUG_PHASE_END(name)                                              \
+    Serial.printf_P(PSTR("[phase] " #name " %lu us | heap %u\n"),           \
+                    micros() - _phase_##name, ESP.getFreeHeap())
 #else
   #define DEBUG_PRINT(x)
+  #define DEBUG_PHASE_BEGIN(name)
+  #define DEBUG_PHASE_END(name)
 #endif
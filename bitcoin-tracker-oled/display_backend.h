@@ -0,0 +1,73 @@
+/**
+ * @file display_backend.h
+ * @brief Compile-time display backend interface (CRTP).
+ *
+ * The sketch talks to the screen only through this interface, so the same
+ * fetching, price state and formatting core drives either panel:
+ *  - OledDisplay (display_oled.h): SH1106G 128×64 OLED
+ *  - LcdDisplay  (display_lcd.h):  16×2 character LCD with I2C backpack
+ *
+ * @c DISPLAY_BACKEND in config.h picks one at compile time.  The base class
+ * forwards to the derived class with a static_cast, so calls resolve at
+ * compile time and inline: no vtable, no virtual dispatch.
+ *
+ * A backend derives from @c DisplayBackend<Self> and implements:
+ * @code
+ * void begin_panel();                                   // panel init; Wire is already up
+ * void draw_message(const __FlashStringHelper* text);   // one status line
+ * void draw_prices(const PriceView& view);              // the price screen
+ * void draw_chart(const ChartView& view);               // the candle chart screen
+ * bool draw_frame(unsigned long now_ms);                // next transition frame, if any
+ * @endcode
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "candle_chart.h"
+#include "price.h"
+#include "tick_history.h"
+
+/// Everything a backend needs to draw one price screen.
+struct PriceView {
+  price_t            current;    ///< latest price
+  price_t            previous;   ///< price shown before this one (same symbol), or @c current
+  price_t            open;       ///< midnight-UTC open, the daily reference
+  const char*        symbol;     ///< base asset, e.g. "BTC"
+  bool               stale;      ///< prices come from the boot snapshot, not the network yet
+  const TickHistory* history;    ///< recent prices of @c symbol, for a sparkline; may be null
+};
+
+/// Everything a backend needs to draw one candle chart screen.
+struct ChartView {
+  const CandleChart* candles;   ///< recent candles of @c symbol, oldest first
+  const char*        symbol;    ///< base asset, e.g. "BTC"
+};
+
+template <class Derived>
+class DisplayBackend {
+ public:
+  /// Initialise the panel.  Call after Wire.begin().
+  void begin() { self().begin_panel(); }
+
+  /// Replace the screen with a short status message ("Connecting...").
+  void message(const __FlashStringHelper* text) { self().draw_message(text); }
+
+  /// Draw the price screen for one symbol.
+  void show(const PriceView& view) { self().draw_prices(view); }
+
+  /// Draw the candle chart screen for one symbol.
+  void chart(const ChartView& view) { self().draw_chart(view); }
+
+  /**
+   * @brief Draw the frame at @p now_ms of the transition started by show().
+   * @return false when no transition is running (nothing was drawn).
+   */
+  bool animate(unsigned long now_ms) { return self().draw_frame(now_ms); }
+
+ protected:
+  DisplayBackend() = default;
+
+ private:
+  Derived& self() { return static_cast<Derived&>(*this); }
+};
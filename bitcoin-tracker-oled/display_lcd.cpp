@@ -0,0 +1,134 @@
+/**
+ * @file display_lcd.cpp
+ * @brief 16×2 character LCD backend implementation.
+ */
+
+#include "config.h"
+
+// Compiled only for the LCD build, so the OLED build does not need the
+// LiquidCrystal_I2C library installed.
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+
+#include "display_lcd.h"
+#include "watchlist.h"
+
+// CGRAM slots 0–7 are mirrored at 8–15; using the mirror keeps the glyph
+// codes non-zero so a row can be handled as an ordinary C string.
+#define GLYPH_ARROW_UP   8
+#define GLYPH_ARROW_DOWN 9
+
+static uint8_t arrow_up[8] = {
+  0b00000, 0b00100, 0b01010, 0b10101, 0b00100, 0b00100, 0b00100, 0b00000,
+};
+static uint8_t arrow_down[8] = {
+  0b00000, 0b00100, 0b00100, 0b00100, 0b10001, 0b01010, 0b00100, 0b00000,
+};
+
+/// Copy @p text into @p row at column @p col, clipped to the row width.
+static void place(char* row, uint8_t col, const char* text) {
+  for (; *text && col < LCD_COLUMNS; text++, col++) row[col] = *text;
+}
+
+/// Format @p value with an explicit sign: "+1150.01" / "-32.50".
+static void format_signed(char* out, int64_t value, uint8_t decimals) {
+  out[0] = (value < 0) ? '-' : '+';
+  price_format(out + 1, (value < 0) ? -value : value, decimals);
+}
+
+void LcdDisplay::begin_panel() {
+  panel_.init();
+  panel_.backlight();
+  panel_.createChar(GLYPH_ARROW_UP - 8,   arrow_up);
+  panel_.createChar(GLYPH_ARROW_DOWN - 8, arrow_down);
+}
+
+void LcdDisplay::write_row(uint8_t line, const char* row) {
+  panel_.setCursor(0, line);
+  panel_.write((const uint8_t*)row, LCD_COLUMNS);
+}
+
+void LcdDisplay::draw_message(const __FlashStringHelper* text) {
+  char row[LCD_COLUMNS + 1];
+  memset(row, ' ', LCD_COLUMNS);
+  row[LCD_COLUMNS] = '\0';
+  strncpy_P(row, (PGM_P)text, LCD_COLUMNS);
+  for (uint8_t i = strlen(row); i < LCD_COLUMNS; i++) row[i] = ' ';
+  write_row(0, row);
+
+  memset(row, ' ', LCD_COLUMNS);
+  write_row(1, row);
+}
+
+void LcdDisplay::draw_prices(const PriceView& view) {
+  char row[LCD_COLUMNS + 1];
+  char text[PRICE_TEXT_SIZE + 1];
+
+  // First row: tick direction, cached tag, price, symbol
+  memset(row, ' ', LCD_COLUMNS);
+  row[LCD_COLUMNS] = '\0';
+  if      (view.current > view.previous) row[0] = GLYPH_ARROW_UP;
+  else if (view.current < view.previous) row[0] = GLYPH_ARROW_DOWN;
+  else                                   row[0] = '=';
+  if (view.stale) row[1] = '*';
+
+  // The symbol is right-aligned and always shown in full: "/$" is added when
+  // there is room, and the price drops its cents before the symbol is cut
+  size_t symbol_len = strlen(view.symbol);
+  size_t len        = price_format(text, view.current, 2);
+  if (2 + len + 1 + symbol_len > LCD_COLUMNS) len = price_format(text, view.current, 0);
+  place(row, 2, text);
+
+  char label[SYMBOL_MAX_LENGTH + sizeof("/$")];
+  snprintf_P(label, sizeof(label),
+             (2 + len + 1 + symbol_len + 2 <= LCD_COLUMNS) ? PSTR("%s/$") : PSTR("%s"),
+             view.symbol);
+  place(row, LCD_COLUMNS - strlen(label), label);
+  write_row(0, row);
+
+  // Second row: change vs the daily open, absolute and in percent
+  memset(row, ' ', LCD_COLUMNS);
+  price_t diff = view.current - view.open;
+  format_signed(text, diff, 2);
+  place(row, 0, text);
+
+  text[0] = (diff < 0) ? '-' : '+';
+  format_fixed(text + 1, price_change_pct(view.current, view.open, 2), 2);
+  place(row, 10, text);
+  row[LCD_COLUMNS - 1] = '%';
+  write_row(1, row);
+}
+
+void LcdDisplay::draw_chart(const ChartView& view) {
+  const CandleChart& chart = *view.candles;
+  char row[LCD_COLUMNS + 1];
+  char text[PRICE_TEXT_SIZE + 1];
+
+  // First row: symbol, candles × interval, direction from first open to last close
+  char title[SYMBOL_MAX_LENGTH + sizeof(" 255x" CHART_INTERVAL)];
+  memset(row, ' ', LCD_COLUMNS);
+  row[LCD_COLUMNS] = '\0';
+  snprintf_P(title, sizeof(title), PSTR("%s %ux" CHART_INTERVAL), view.symbol, chart.size());
+  place(row, 0, title);
+  if (chart.size() > 0) {
+    uint8_t first = chart.candle(0).open;
+    uint8_t last  = chart.candle(chart.size() - 1).close;
+    row[LCD_COLUMNS - 1] = (last > first) ? GLYPH_ARROW_UP
+                         : (last < first) ? GLYPH_ARROW_DOWN
+                         : '=';
+  }
+  write_row(0, row);
+
+  // Second row: lowest low – highest high
+  memset(row, ' ', LCD_COLUMNS);
+  if (chart.size() > 0) {
+    uint8_t decimals = (chart.highest() >= PRICE_UNITS(1000)) ? 0 : 2;
+    size_t  len      = price_format(text, chart.lowest(), decimals);
+    place(row, 0, text);
+    place(row, len, " - ");
+    price_format(text, chart.highest(), decimals);
+    place(row, len + 3, text);
+  }
+  write_row(1, row);
+}
+
+#endif // DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
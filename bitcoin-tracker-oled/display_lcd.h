@@ -0,0 +1,52 @@
+/**
+ * @file display_lcd.h
+ * @brief 16×2 character LCD backend (@c DISPLAY_BACKEND_LCD).
+ *
+ * Layout (the one from the former bitcoin-tracker-lcd sketch):
+ * @verbatim
+ * ┌────────────────┐
+ * │↑*60950.01 BTC/$│  ← tick direction, cached tag, price, symbol
+ * │+1150.01  +1.92%│  ← change vs the midnight-UTC open, absolute and %
+ * └────────────────┘
+ * @endverbatim
+ *
+ * Symbols of up to @c SYMBOL_MAX_LENGTH characters are shown in full: the
+ * "/$" goes first, then the cents ("↑*60950 DOGEUSD").
+ *
+ * The chart screen has no room for candles; it shows their range instead:
+ * @verbatim
+ * ┌────────────────┐
+ * │BTC 64x15m     ↑│  ← candles × interval, direction over the period
+ * │59012 - 61234   │  ← lowest low – highest high
+ * └────────────────┘
+ * @endverbatim
+ *
+ * Each row is composed into a fixed char buffer and written over the old
+ * one in place; no clear() (which blanks the panel for ~2 ms and flickers),
+ * no String, no heap.
+ */
+#pragma once
+
+#include <LiquidCrystal_I2C.h>
+
+#include "config.h"
+#include "display_backend.h"
+
+class LcdDisplay : public DisplayBackend<LcdDisplay> {
+ public:
+  LcdDisplay() : panel_(LCD_I2C_ADDR, LCD_COLUMNS, LCD_ROWS) {}
+
+ private:
+  friend class DisplayBackend<LcdDisplay>;
+
+  void begin_panel();
+  void draw_message(const __FlashStringHelper* text);
+  void draw_prices(const PriceView& view);
+  void draw_chart(const ChartView& view);
+  bool draw_frame(unsigned long) { return false; }   // no transitions on a character panel
+
+  /// Write @p row (exactly LCD_COLUMNS bytes, may contain custom glyphs) to line @p line.
+  void write_row(uint8_t line, const char* row);
+
+  LiquidCrystal_I2C panel_;
+};
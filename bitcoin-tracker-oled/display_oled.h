@@ -0,0 +1,75 @@
+/**
+ * @file display_oled.h
+ * @brief SH1106G 128×64 OLED backend (@c DISPLAY_BACKEND_OLED).
+ *
+ * Thin adapter from DisplayBackend to the layout and partial refresh in
+ * display_utils.h, plus the price tick transitions of price_anim.h.  The bus
+ * runs at @c OLED_I2C_CLOCK both during and after the library's own
+ * transfers, since display_flush() writes to Wire directly.
+ */
+#pragma once
+
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SH110X.h>
+
+#include "config.h"
+#include "debug.h"
+#include "display_backend.h"
+#include "display_utils.h"
+#include "price_anim.h"
+
+class OledDisplay : public DisplayBackend<OledDisplay> {
+ public:
+  OledDisplay()
+      : panel_(OLED_WIDTH, OLED_HEIGHT, &Wire, OLED_RESET, OLED_I2C_CLOCK, OLED_I2C_CLOCK) {}
+
+ private:
+  friend class DisplayBackend<OledDisplay>;
+
+  void begin_panel() {
+    panel_.begin(OLED_I2C_ADDR, true);
+    panel_.setTextColor(SH110X_WHITE);
+    if (ANIMATE_PRICE_TICKS) anim_.begin();
+  }
+
+  void draw_message(const __FlashStringHelper* text) {
+    anim_.stop();
+    panel_.clearDisplay();
+    panel_.setTextSize(1);
+    panel_.setCursor(0, 0);
+    panel_.println(text);
+    display_flush(panel_);
+  }
+
+  void draw_prices(const PriceView& view) {
+    compose_screen(panel_, view.current, view.previous, view.open, view.symbol, view.stale,
+                   view.history);
+    if (ANIMATE_PRICE_TICKS && view.previous != view.current) {
+      // The first stage goes out with the frame, so the new digits never show early
+      unsigned long now = millis();
+      anim_.start(view.previous, view.current, now);
+      anim_.frame(panel_.getBuffer(), now);
+    } else {
+      anim_.stop();
+    }
+    display_flush(panel_);
+    DEBUG_PRINT(display_last_flush_bytes());
+  }
+
+  void draw_chart(const ChartView& view) {
+    anim_.stop();
+    print_chart(panel_, *view.candles, view.symbol);
+    DEBUG_PRINT(display_last_flush_bytes());
+  }
+
+  bool draw_frame(unsigned long now_ms) {
+    if (!anim_.active()) return false;
+    anim_.frame(panel_.getBuffer(), now_ms);
+    display_flush(panel_);
+    return true;
+  }
+
+  Adafruit_SH1106G panel_;
+  PriceAnimation   anim_;
+};
@@ -3,37 +3,134 @@
  * @brief OLED rendering implementation for the Bitcoin tracker.
  */
 
+#include "config.h"
+
+// Compiled only for the OLED build, so the LCD build does not need the
+// Adafruit libraries installed.
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_OLED
+
 #include "display_utils.h"
 #include <avr/pgmspace.h>
+#include <Wire.h>
 
-#include "config.h"
 #include "icons.h"
+#include "watchlist.h"
+
+// The SH1106 has 132 columns of RAM; a 128-px panel is wired to columns 2–129.
+#define SH1106_COLUMN_OFFSET 2
+#define SH1106_PAGES         (OLED_HEIGHT / 8)
+
+// I2C control bytes: following bytes are commands / display data.
+#define SH1106_CONTROL_COMMAND 0x00
+#define SH1106_CONTROL_DATA    0x40
+
+// Data bytes per I2C transaction (plus the control byte = 32, the transfer
+// size Adafruit's I2C layer uses as well).
+#define SH1106_DATA_CHUNK 31
+
+// Opening a new window costs 3 command bytes and 2 control bytes, so gaps
+// of unchanged columns shorter than this are cheaper to resend than to skip.
+#define SH1106_WINDOW_COST 5
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Partial refresh state
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Copy of what the panel currently shows, in SH1106 page layout.
+static uint8_t  sent_frame[OLED_WIDTH * SH1106_PAGES];
+static bool     sent_valid  = false;
+static uint32_t flush_bytes = 0;
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Internal helpers
 // ─────────────────────────────────────────────────────────────────────────────
 
+/// Point the SH1106 write cursor at @p column of @p page.
+static void set_window(uint8_t page, uint8_t column) {
+  uint8_t col = column + SH1106_COLUMN_OFFSET;
+  Wire.beginTransmission(OLED_I2C_ADDR);
+  Wire.write(SH1106_CONTROL_COMMAND);
+  Wire.write(0xB0 | page);           // page address
+  Wire.write(0x10 | (col >> 4));     // column address, high nibble
+  Wire.write(col & 0x0F);            // column address, low nibble
+  Wire.endTransmission();
+  flush_bytes += 4;
+}
+
+/// Stream @p len bytes of display data starting at the current cursor.
+static void send_data(const uint8_t* data, uint16_t len) {
+  while (len > 0) {
+    uint8_t chunk = (len > SH1106_DATA_CHUNK) ? SH1106_DATA_CHUNK : len;
+    Wire.beginTransmission(OLED_I2C_ADDR);
+    Wire.write(SH1106_CONTROL_DATA);
+    Wire.write(data, chunk);
+    Wire.endTransmission();
+    flush_bytes += chunk + 1;
+    data += chunk;
+    len  -= chunk;
+  }
+}
+
+/**
+ * @brief Send the changed column runs of one page.
+ *
+ * Runs separated by fewer than SH1106_WINDOW_COST unchanged columns are
+ * merged, since re-addressing would cost more than resending the gap.
+ */
+static void flush_page(uint8_t page, const uint8_t* frame) {
+  const uint8_t* row  = frame + page * OLED_WIDTH;
+  uint8_t*       sent = sent_frame + page * OLED_WIDTH;
+
+  int col = 0;
+  while (col < OLED_WIDTH) {
+    if (sent_valid && row[col] == sent[col]) {
+      col++;
+      continue;
+    }
+
+    // Extend the run until a long enough stretch of unchanged columns
+    int start = col;
+    int end   = col;                  // last changed column in the run
+    for (int i = col + 1; i < OLED_WIDTH && i - end <= SH1106_WINDOW_COST; i++) {
+      if (!sent_valid || row[i] != sent[i]) end = i;
+    }
+
+    set_window(page, start);
+    send_data(row + start, end - start + 1);
+    memcpy(sent + start, row + start, end - start + 1);
+    col = end + 1;
+  }
+}
+
 /**
- * @brief Select and draw the direction bitmap based on a % change value.
+ * @brief Select and draw the direction bitmap based on the change vs the open.
  *
  * Thresholds (absolute %, with sign):
  *   ≥ +3.5 → double-up   /  ≤ −3.5 → double-down
  *   ≥ +1.5 → single-up   /  ≤ −1.5 → single-down
  *   ≥  0   → thin-up     /  < 0    → thin-down
+ *
+ * Compared exactly in integer arithmetic via price_change_cmp().
  */
-static void draw_direction_icon(Adafruit_SH1106G& display, double pct_diff) {
+static void draw_direction_icon(Adafruit_GFX& display,
+                                price_t current_price, price_t closing_price) {
   const unsigned char* bmp;
 
-  if      (pct_diff >= 3.5)  bmp = bitmap_up_double;
-  else if (pct_diff >= 1.5)  bmp = bitmap_up_single;
-  else if (pct_diff >= 0)    bmp = bitmap_up_thin;
-  else if (pct_diff > -1.5)  bmp = bitmap_down_thin;
-  else if (pct_diff > -3.5)  bmp = bitmap_down_single;
-  else                       bmp = bitmap_down_double;
+  if      (price_change_cmp(current_price, closing_price,  35) >= 0) bmp = bitmap_up_double;
+  else if (price_change_cmp(current_price, closing_price,  15) >= 0) bmp = bitmap_up_single;
+  else if (price_change_cmp(current_price, closing_price,   0) >= 0) bmp = bitmap_up_thin;
+  else if (price_change_cmp(current_price, closing_price, -15) >  0) bmp = bitmap_down_thin;
+  else if (price_change_cmp(current_price, closing_price, -35) >  0) bmp = bitmap_down_single;
+  else                                                               bmp = bitmap_down_double;
 
   display.drawBitmap(59, 37, bmp, ICON_WIDTH, ICON_HEIGHT, SH110X_WHITE);
 }
 
+/// Print the first @p len characters of @p text.
+static void print_span(Adafruit_GFX& display, const char* text, size_t len) {
+  display.write((const uint8_t*)text, len);
+}
+
 /**
  * @brief Render the price number, choosing size and decimal precision by range.
  *
@@ -47,37 +144,24 @@ static void draw_direction_icon(Adafruit_SH1106G& display, double pct_diff) {
  * | ≥ 1 000       | 2–5            | 2 digits (size 2) |
  * | ≥ 10          | 2–3            | 2 digits (size 2) |
  * | < 10          | 1              | 4 digits (size 3) |
+ *
+ * The text is the price rounded to 4 decimals, then cut to what fits.
  */
-static void draw_price(Adafruit_SH1106G& display, double price) {
+static void draw_price(Adafruit_GFX& display, price_t price) {
+  char        s[PRICE_TEXT_SIZE];
+  PriceLayout at = price_layout(price, s);
+
   display.setTextSize(3);
-  String s         = String(price, 4);
-  int    dec_index = s.indexOf('.');
-
-  if (price >= 1000000) {
-    display.setCursor(0, 4);
-    display.print(s.substring(0, dec_index));
-  } else if (price >= 100000) {
-    display.setCursor(5, 4);
-    display.print(s.substring(0, dec_index));
-  } else if (price >= 1000) {
-    display.setCursor(5, 4);
-    display.print(s.substring(0, dec_index));
-    display.setTextSize(2);
-    display.setCursor(dec_index * 17 + 5, 11);
-    display.print(s.substring(dec_index, dec_index + (7 - dec_index)));
-  } else if (price >= 10) {
-    display.setCursor(20, 4);
-    display.print(s.substring(0, dec_index));
+  display.setCursor(at.x, 4);
+  print_span(display, s, at.large);
+  if (at.small > 0) {
     display.setTextSize(2);
-    display.setCursor(dec_index * 17 + 20, 11);
-    display.print(s.substring(dec_index, dec_index + (6 - dec_index)));
-  } else {
-    display.setCursor(5, 4);
-    display.print(s);
+    display.setCursor(at.small_x, 11);
+    print_span(display, s + at.large, at.small);
   }
 
   // Dollar sign — omitted only when the price overflows at ≥ $1 M
-  if (price < 1000000) {
+  if (price < PRICE_UNITS(1000000)) {
     display.setCursor(115, 11);
     display.setTextSize(2);
     display.print('$');
@@ -87,29 +171,37 @@ static void draw_price(Adafruit_SH1106G& display, double price) {
 /**
  * @brief Render the percentage change, and optionally the absolute change.
  *
- * Controlled by DIFF_PRINT_PERCENTAGE_AND_VALUE in config.h:
+ * @p show_value defaults to DIFF_PRINT_PERCENTAGE_AND_VALUE in config.h:
  *   false → percentage only, text-size 2 (larger, easier to read at a glance)
  *   true  → percentage + absolute $ change, text-size 1 (compact)
  */
-static void draw_change(Adafruit_SH1106G& display,
-                        double current_price, double closing_price) {
-  float pct = fabsf((float)(current_price - closing_price)
-                    / (float)closing_price * 100.0f);
+static void draw_change(Adafruit_GFX& display,
+                        price_t current_price, price_t closing_price, bool show_value) {
+  char text[PRICE_TEXT_SIZE];
 
-  if (DIFF_PRINT_PERCENTAGE_AND_VALUE) {
+  if (show_value) {
     display.setCursor(80, 35);
     display.setTextSize(1);
-    display.print(pct, 2);
+    format_fixed(text, price_change_pct(current_price, closing_price, 2), 2);
+    display.print(text);
     display.print('%');
 
+    price_t diff = current_price - closing_price;
     display.setCursor(80, 45);
     display.setTextSize(1);
-    display.print((float)fabs(current_price - closing_price), 2);
+    price_format(text, (diff < 0) ? -diff : diff, 2);
+    display.print(text);
   } else {
+    // Below 10 % there is room for one decimal digit
+    bool small = price_change_cmp(current_price, closing_price,  100) < 0
+              && price_change_cmp(current_price, closing_price, -100) > 0;
+    uint8_t decimals = small ? 1 : 0;
+
     display.setCursor(80, 37);
     display.setTextSize(2);
-    display.print(pct, (pct < 10.0f) ? 1 : 0);
-    if (pct >= 10.0f) {
+    format_fixed(text, price_change_pct(current_price, closing_price, decimals), decimals);
+    display.print(text);
+    if (!small) {
       // Nudge the '%' sign closer when there is no decimal digit
       display.setTextSize(1);
       display.print(' ');
@@ -123,24 +215,188 @@ static void draw_change(Adafruit_SH1106G& display,
 // Public API
 // ─────────────────────────────────────────────────────────────────────────────
 
-void print_to_screen(Adafruit_SH1106G& display,
-                     double            current_price,
-                     double            /*previous_price*/,   // reserved for future use
-                     double            closing_price,
-                     const char*       symbol) {
-  display.clearDisplay();
+PriceLayout price_layout(price_t price, char* text) {
+  uint8_t len       = price_format(text, price, 4);
+  uint8_t dec_index = strchr(text, '.') - text;
+
+  PriceLayout at = { 5, dec_index, 0, 0 };
+  if (price >= PRICE_UNITS(1000000)) {
+    at.x = 0;
+  } else if (price >= PRICE_UNITS(100000)) {
+    // Integer digits only
+  } else if (price >= PRICE_UNITS(1000)) {
+    at.small = 7 - dec_index;                // decimals at size 2, as many as fit
+  } else if (price >= PRICE_UNITS(10)) {
+    at.x     = 20;
+    at.small = 6 - dec_index;
+  } else {
+    at.large = len;                          // below $10 everything is large
+  }
+  at.small_x = dec_index * 17 + at.x;
+  return at;
+}
 
+void render_screen(Adafruit_GFX& display,
+                   price_t       current_price,
+                   price_t       previous_price,
+                   price_t       closing_price,
+                   const char*   symbol,
+                   bool          stale,
+                   bool          show_value) {
+  (void)previous_price;                      // animated by price_anim.h, not laid out here
   draw_price(display, current_price);
 
-  // Symbol label inside a rounded rectangle
-  display.setCursor(15, 37);
-  display.setTextSize(2);
+  // Symbol label centred in a rounded rectangle; longer symbols at size 1
+  uint8_t size  = symbol_label_size(symbol);
+  int16_t width = label_width(strlen(symbol), size);
+  display.setCursor(10 + (SYMBOL_BOX_WIDTH - width) / 2, 32 + (SYMBOL_BOX_HEIGHT - 7 * size) / 2);
+  display.setTextSize(size);
+  display.print(symbol);
+  display.drawRoundRect(10, 32, SYMBOL_BOX_WIDTH, SYMBOL_BOX_HEIGHT, 8, SH110X_WHITE);
+
+  draw_direction_icon(display, current_price, closing_price);
+  draw_change(display, current_price, closing_price, show_value);
+
+  // Bottom-right corner, below the change figures
+  if (stale) {
+    display.setTextSize(1);
+    display.setCursor(92, 57);
+    display.print(F("cached"));
+  }
+}
+
+void draw_sparkline(Adafruit_GFX&      display,
+                    const TickHistory& history,
+                    int16_t            x,
+                    int16_t            y,
+                    int16_t            w,
+                    int16_t            h) {
+  uint16_t count = history.size();
+  if (count < 2) return;
+
+  price_t lo    = history.lowest();
+  price_t range = history.highest() - lo;
+  int16_t bottom = y + h - 1;
+
+  // One pass over the decoder; each sample is joined to the one before it
+  uint16_t i      = 0;
+  int16_t  prev_x = 0;
+  int16_t  prev_y = 0;
+  history.for_each([&](price_t price) {
+    int16_t px = x + (int16_t)((int32_t)i * (w - 1) / (count - 1));
+    int16_t py = (range == 0) ? y + (h - 1) / 2
+                              : bottom - (int16_t)((price - lo) * (h - 1) / range);
+    if (i > 0) display.drawLine(prev_x, prev_y, px, py, SH110X_WHITE);
+    prev_x = px;
+    prev_y = py;
+    i++;
+  });
+}
+
+void compose_screen(Adafruit_SH1106G&  display,
+                    price_t            current_price,
+                    price_t            previous_price,
+                    price_t            closing_price,
+                    const char*        symbol,
+                    bool               stale,
+                    const TickHistory* history) {
+  display.clearDisplay();
+  render_screen(display, current_price, previous_price, closing_price, symbol, stale);
+  // Bottom strip, left of the "cached" tag
+  if (SHOW_SPARKLINE && history != nullptr) draw_sparkline(display, *history, 0, 57, 90, 7);
+}
+
+void print_to_screen(Adafruit_SH1106G&  display,
+                     price_t            current_price,
+                     price_t            previous_price,
+                     price_t            closing_price,
+                     const char*        symbol,
+                     bool               stale,
+                     const TickHistory* history) {
+  compose_screen(display, current_price, previous_price, closing_price, symbol, stale, history);
+  display_flush(display);
+}
+
+void render_chart(Adafruit_GFX& display, const CandleChart& chart, const char* symbol) {
+  // Header: symbol and interval on the left, the price range on the right
+  uint8_t count = chart.size();
+  char    range[2 * PRICE_TEXT_SIZE];
+  size_t  len   = 0;
+  if (count > 0) {
+    price_t high     = chart.highest();
+    uint8_t decimals = (high >= PRICE_UNITS(1000)) ? 0 : (high >= PRICE_UNITS(1)) ? 2 : 4;
+    len          = price_format(range, chart.lowest(), decimals);
+    range[len++] = '-';
+    len         += price_format(range + len, high, decimals);
+  }
+
+  // A long symbol keeps its full name; the interval gives way to the range
+  size_t title = strlen(symbol) + 1 + strlen(CHART_INTERVAL);
+  display.setTextSize(1);
+  display.setCursor(0, 0);
   display.print(symbol);
-  display.drawRoundRect(10, 32, 44, 24, 8, SH110X_WHITE);
+  if (len == 0 || 6 * (title + 1 + len) <= OLED_WIDTH) {
+    display.print(' ');
+    display.print(F(CHART_INTERVAL));
+  }
+  if (count == 0) return;
+
+  display.setCursor(OLED_WIDTH - 6 * len, 0);
+  display.print(range);
+
+  // Candles below the header, newest against the right edge
+  const int16_t top    = 10;
+  const int16_t height = OLED_HEIGHT - top;
+  uint8_t first = (count > OLED_WIDTH) ? count - OLED_WIDTH : 0;
+  int16_t pitch = OLED_WIDTH / (count - first);
+  int16_t body  = (pitch > 2) ? pitch - 1 : pitch;
+  int16_t x     = OLED_WIDTH - (count - first) * pitch;
 
-  double pct_diff = (current_price - closing_price) / closing_price * 100.0;
-  draw_direction_icon(display, pct_diff);
-  draw_change(display, current_price, closing_price);
+  auto y_of = [&](uint8_t level) -> int16_t {
+    return top + height - 1 - (int16_t)level * (height - 1) / CANDLE_LEVELS;
+  };
 
-  display.display();
+  for (uint8_t i = first; i < count; i++, x += pitch) {
+    const CandleChart::Candle& c = chart.candle(i);
+    bool    rising = c.close >= c.open;
+    int16_t y_top  = y_of(rising ? c.close : c.open);
+    int16_t y_bot  = y_of(rising ? c.open  : c.close);
+    int16_t wick   = x + (body - 1) / 2;
+
+    display.drawFastVLine(wick, y_of(c.high), y_of(c.low) - y_of(c.high) + 1, SH110X_WHITE);
+    if (!rising) {
+      display.fillRect(x, y_top, body, y_bot - y_top + 1, SH110X_WHITE);
+    } else if (body >= 3) {
+      display.drawRect(x, y_top, body, y_bot - y_top + 1, SH110X_WHITE);
+      if (y_bot - y_top > 1) {
+        display.fillRect(x + 1, y_top + 1, body - 2, y_bot - y_top - 1, SH110X_BLACK);
+      }
+    }
+    // A rising candle narrower than 3 px is just its wick
+  }
 }
+
+void print_chart(Adafruit_SH1106G& display, const CandleChart& chart, const char* symbol) {
+  display.clearDisplay();
+  render_chart(display, chart, symbol);
+  display_flush(display);
+}
+
+void display_flush(Adafruit_SH1106G& display) {
+  const uint8_t* frame = display.getBuffer();
+  flush_bytes = 0;
+  for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+    flush_page(page, frame);
+  }
+  sent_valid = true;
+}
+
+void display_invalidate() {
+  sent_valid = false;
+}
+
+uint32_t display_last_flush_bytes() {
+  return flush_bytes;
+}
+
+#endif // DISPLAY_BACKEND == DISPLAY_BACKEND_OLED
@@ -2,15 +2,22 @@
  * @file display_utils.h
  * @brief OLED rendering helper for the Bitcoin tracker.
  *
- * The single public function @ref print_to_screen takes the display instance
- * by reference so that this module has no global state and no dependency on
- * the sketch's global @c display object.
+ * The public functions take the display instance by reference so that this
+ * module has no global state and no dependency on the sketch's global
+ * @c display object.  The layout itself (@ref render_screen) only needs the
+ * generic Adafruit_GFX interface, so it can also draw into an off-screen
+ * GFXcanvas1 without any OLED attached.
  */
 #pragma once
 
 #include <Adafruit_GFX.h>
 #include <Adafruit_SH110X.h>
 
+#include "candle_chart.h"
+#include "config.h"
+#include "price.h"
+#include "tick_history.h"
+
 /**
  * @brief Render the full price screen on the SH1106G OLED.
  *
@@ -41,17 +48,132 @@
  * percentage and the absolute dollar change are shown in a smaller font.
  * When @c false, only the percentage is rendered in a larger font.
  *
+ * All prices are fixed-point (price.h); every computation and all text
+ * formatting is done in integer arithmetic.
+ *
  * @param display        Reference to the SH1106G display instance.
  * @param current_price  Most recently fetched price.
- * @param previous_price Price from the previous poll cycle.
- *                       Reserved for future use (e.g. flash animation on
- *                       direction change); not rendered at the moment.
+ * @param previous_price Price on screen before this one.  The frame itself
+ *                       shows only @p current_price; the digit roll and flash
+ *                       from @p previous_price are drawn over it by the OLED
+ *                       backend (price_anim.h, display_oled.h).
  * @param closing_price  Midnight-UTC open price used as the daily reference.
- * @param symbol         Asset label shown in the rounded-rectangle box.
- *                       Should be ≤ 3 characters to fit the layout (e.g. "BTC").
+ * @param symbol         Asset label shown in the rounded-rectangle box, at
+ *                       most @c SYMBOL_MAX_LENGTH characters (watchlist.h):
+ *                       up to 3 at text size 2 (e.g. "BTC"), longer at size 1.
+ * @param stale          Prices come from the boot snapshot (boot_cache.h), not
+ *                       the network yet; a small "cached" tag is drawn.
+ * @param history        Recent prices of @p symbol, drawn as a sparkline along
+ *                       the bottom edge when @c SHOW_SPARKLINE is set; may be
+ *                       @c nullptr.
+ */
+void print_to_screen(Adafruit_SH1106G&  display,
+                     price_t            current_price,
+                     price_t            previous_price,
+                     price_t            closing_price,
+                     const char*        symbol,
+                     bool               stale   = false,
+                     const TickHistory* history = nullptr);
+
+/// Same as @ref print_to_screen, but the frame is left in the buffer, not flushed.
+void compose_screen(Adafruit_SH1106G&  display,
+                    price_t            current_price,
+                    price_t            previous_price,
+                    price_t            closing_price,
+                    const char*        symbol,
+                    bool               stale   = false,
+                    const TickHistory* history = nullptr);
+
+/**
+ * @brief Draw the price screen into any Adafruit_GFX target.
+ *
+ * Same layout and arguments as @ref print_to_screen, but the target is
+ * neither cleared nor flushed: the caller owns the framebuffer.  This is the
+ * hardware-independent part of rendering.
+ *
+ * @param show_value  Overrides @c DIFF_PRINT_PERCENTAGE_AND_VALUE, so both
+ *                    layouts can be drawn from one build (the host test
+ *                    test_render_golden does).
+ */
+void render_screen(Adafruit_GFX& display,
+                   price_t       current_price,
+                   price_t       previous_price,
+                   price_t       closing_price,
+                   const char*   symbol,
+                   bool          stale      = false,
+                   bool          show_value = DIFF_PRINT_PERCENTAGE_AND_VALUE);
+
+/**
+ * @brief Draw @p history as a line chart in the box (@p x, @p y, @p w, @p h).
+ *
+ * The samples are spread evenly over the width and scaled between their own
+ * lowest and highest value, so even a quiet market fills the height.  Nothing
+ * is drawn with fewer than two samples; a flat history is a line at mid-height.
+ */
+void draw_sparkline(Adafruit_GFX&      display,
+                    const TickHistory& history,
+                    int16_t            x,
+                    int16_t            y,
+                    int16_t            w,
+                    int16_t            h);
+
+/// Where the price screen draws each part of the price text.
+struct PriceLayout {
+  int16_t x;          ///< left edge of the size-3 part (18 px per character, top at y = 4)
+  uint8_t large;      ///< leading characters drawn at size 3
+  int16_t small_x;    ///< left edge of the size-2 decimals (12 px per character, top at y = 11)
+  uint8_t small;      ///< characters drawn at size 2 after the large ones; 0 if none
+};
+
+/**
+ * @brief Format @p price into @p text as the price screen does, and lay it out.
+ *
+ * The layout of the price number, as drawn by @ref render_screen.  Also
+ * used by price_anim.h to find the digits on screen without laying out text.
+ *
+ * @param text  Buffer of at least PRICE_TEXT_SIZE bytes.
  */
-void print_to_screen(Adafruit_SH1106G& display,
-                     double            current_price,
-                     double            previous_price,
-                     double            closing_price,
-                     const char*       symbol);
+PriceLayout price_layout(price_t price, char* text);
+
+/**
+ * @brief Render the candle chart screen on the SH1106G OLED.
+ *
+ * Screen layout (128 × 64 px):
+ * @verbatim
+ * ┌──────────────────────────────────┐
+ * │ BTC 15m            59012-61234   │  ← text size 1: interval, low–high
+ * │      │  ┃                        │
+ * │  ┃  ┃┃ │┃┃      ┃                │  ← one candle per CHART_CANDLES slot,
+ * │ ┃┃┃┃  ┃   ┃┃┃ ┃┃┃┃┃┃             │    newest at the right edge
+ * └──────────────────────────────────┘
+ * @endverbatim
+ *
+ * When a long symbol would run into the range, the interval is left out of
+ * the header.  The candles fill the height between the lowest low and the
+ * highest high.
+ * Falling candles are drawn filled.  Rising candles are drawn hollow when
+ * there are at least 3 px per candle, and as a thin bar otherwise.
+ */
+void print_chart(Adafruit_SH1106G& display, const CandleChart& chart, const char* symbol);
+
+/// Same as @ref print_chart, into any Adafruit_GFX target, without clearing or flushing.
+void render_chart(Adafruit_GFX& display, const CandleChart& chart, const char* symbol);
+
+/**
+ * @brief Push only the changed parts of the framebuffer to the panel.
+ *
+ * Replacement for @c display.display().  The framebuffer is diffed against
+ * a copy of the last frame sent (1 KB of RAM), page by page; each run of
+ * changed columns is sent as its own page/column window.  A typical price
+ * tick, where only the last digits and the percentage change, moves a few
+ * dozen bytes over I2C instead of the full 1 KB frame.
+ *
+ * The first call after boot (or @ref display_invalidate) sends everything.
+ */
+void display_flush(Adafruit_SH1106G& display);
+
+/// Forget what the panel shows; the next @ref display_flush sends a full frame.
+void display_invalidate();
+
+/// I2C bytes (control + command + data) written by the last @ref display_flush.
+uint32_t display_last_flush_bytes();
@@ -0,0 +1,135 @@
+/**
+ * @file json_scanner.cpp
+ * @brief Allocation-free JSON scanner implementation.
+ */
+
+#include "json_scanner.h"
+
+void JsonScanner::reset() {
+  key_[0]   = value_[0] = '\0';
+  key_len_  = value_len_ = 0;
+  depth_    = 0;
+  overflow_ = 0;
+  arrays_   = 0;
+  index_[0] = 0;
+  in_string_ = in_token_ = escaped_ = reading_key_ = false;
+  key_overflow_ = expect_value_ = advance_ = done_ = false;
+}
+
+bool JsonScanner::key_is(PGM_P key_P) const {
+  return !in_array() && !key_overflow_ && strcmp_P(key_, key_P) == 0;
+}
+
+void JsonScanner::begin_element() {
+  if (advance_) {
+    index_[depth_]++;
+    advance_ = false;
+  }
+}
+
+void JsonScanner::push(bool array) {
+  begin_element();
+  if (depth_ >= JSON_MAX_DEPTH) {         // deeper levels are flattened
+    overflow_++;
+    return;
+  }
+  depth_++;
+  if (array) arrays_ |= (1u << depth_);
+  else       arrays_ &= ~(1u << depth_);
+  index_[depth_] = 0;
+  expect_value_  = false;
+}
+
+void JsonScanner::pop() {
+  advance_ = false;
+  if (overflow_ > 0) {
+    overflow_--;
+    return;
+  }
+  if (depth_ == 0) return;
+  depth_--;
+  expect_value_ = false;
+  if (depth_ == 0) done_ = true;
+}
+
+void JsonScanner::value_done() {
+  value_[value_len_] = '\0';
+  expect_value_ = false;
+  if (depth_ == 0) done_ = true;
+}
+
+uint8_t JsonScanner::feed(char c) {
+  uint8_t events = 0;
+
+  if (in_string_) {
+    if (escaped_) {
+      escaped_ = false;
+    } else if (c == '\\') {
+      escaped_ = true;
+      return 0;
+    } else if (c == '"') {
+      in_string_ = false;
+      if (reading_key_) {
+        key_[key_len_] = '\0';
+        return 0;
+      }
+      value_done();
+      return JSON_VALUE;
+    }
+
+    if (reading_key_) {
+      if (key_len_ < JSON_KEY_SIZE - 1) key_[key_len_++] = c;
+      else                              key_overflow_ = true;
+    } else if (value_len_ < JSON_VALUE_SIZE - 1) {
+      value_[value_len_++] = c;
+    }
+    return 0;
+  }
+
+  if (in_token_) {
+    switch (c) {
+      case ',': case '}': case ']':
+      case ' ': case '\t': case '\r': case '\n':
+        in_token_ = false;
+        value_done();
+        events |= JSON_VALUE;
+        break;                            // fall through to structural handling
+      default:
+        if (value_len_ < JSON_VALUE_SIZE - 1) value_[value_len_++] = c;
+        return 0;
+    }
+  }
+
+  switch (c) {
+    case '"':
+      in_string_   = true;
+      reading_key_ = !in_array() && depth_ > 0 && !expect_value_;
+      if (reading_key_) {
+        key_len_      = 0;
+        key_overflow_ = false;
+      } else {
+        begin_element();
+        value_len_ = 0;
+      }
+      break;
+    case '{': push(false);                         break;
+    case '[': push(true);                          break;
+    case '}':
+    case ']': pop(); events |= JSON_END;           break;
+    case ':': expect_value_ = true;                break;
+    case ',':
+      // Advanced lazily so index_at() still describes a number that was
+      // completed by this very comma.
+      advance_      = in_array();
+      expect_value_ = false;
+      break;
+    case ' ': case '\t': case '\r': case '\n':     break;
+    default:                                       // number, true/false/null
+      begin_element();
+      in_token_  = true;
+      value_len_ = 0;
+      value_[value_len_++] = c;
+      break;
+  }
+  return events;
+}
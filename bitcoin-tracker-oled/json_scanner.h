@@ -0,0 +1,89 @@
+/**
+ * @file json_scanner.h
+ * @brief Allocation-free, byte-at-a-time JSON scanner for Binance responses.
+ *
+ * The tracker only ever needs a handful of scalar values out of small, well
+ * formed JSON documents, so a full DOM (ArduinoJson) is overkill.  The
+ * scanner is fed one byte at a time and reports each completed scalar value
+ * together with its key (inside objects) or element index (inside arrays).
+ * Everything lives in a few dozen bytes of fixed state; nothing is
+ * allocated and no document is ever held in memory.
+ *
+ * @code
+ * JsonScanner json;
+ * while (!json.done() && (c = next_byte()) >= 0) {
+ *   if ((json.feed(c) & JSON_VALUE) && json.key_is(PSTR("price"))) use(json.value());
+ * }
+ * @endcode
+ *
+ * Values longer than the internal buffer are truncated; keys longer than
+ * the key buffer never match.  Both limits are far above anything the
+ * Binance endpoints used here return.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#define JSON_MAX_DEPTH 8
+#define JSON_KEY_SIZE  16
+#define JSON_VALUE_SIZE 24
+
+/// Bit flags returned by JsonScanner::feed().
+#define JSON_VALUE 0x01   ///< a scalar value just completed; see key()/value()
+#define JSON_END   0x02   ///< an object or array just closed
+
+class JsonScanner {
+ public:
+  JsonScanner() { reset(); }
+
+  /// Forget all state; the next byte starts a new document.
+  void reset();
+
+  /**
+   * @brief Consume one byte of JSON.
+   * @return Bitwise OR of @c JSON_VALUE / @c JSON_END, or 0.
+   *
+   * A number or literal completes on the delimiter that follows it, so a
+   * single call can report both a value and the container it closes.
+   */
+  uint8_t feed(char c);
+
+  /// True once the top-level value has been read completely.
+  bool done() const { return done_; }
+
+  /// Text of the value reported by the last @c JSON_VALUE (quotes removed).
+  const char* value() const { return value_; }
+
+  /// True if the last value is a member of an object whose key equals @p key_P (PROGMEM).
+  bool key_is(PGM_P key_P) const;
+
+  /// Current nesting depth: 0 at top level, 1 inside the outer container, …
+  uint8_t depth() const { return depth_; }
+
+  /// Index of the current element within the array at @p level (1-based depth).
+  uint16_t index_at(uint8_t level) const { return index_[level]; }
+
+ private:
+  bool in_array() const { return depth_ > 0 && (arrays_ & (1u << depth_)); }
+  void begin_element();
+  void push(bool array);
+  void pop();
+  void value_done();
+
+  char     key_[JSON_KEY_SIZE];
+  char     value_[JSON_VALUE_SIZE];
+  uint8_t  key_len_;
+  uint8_t  value_len_;
+  uint8_t  depth_;
+  uint8_t  overflow_;                   ///< levels opened beyond JSON_MAX_DEPTH
+  uint16_t arrays_;                     ///< bit n set → container at depth n is an array
+  uint16_t index_[JSON_MAX_DEPTH + 1];
+  bool     in_string_;
+  bool     in_token_;
+  bool     escaped_;
+  bool     reading_key_;
+  bool     key_overflow_;
+  bool     expect_value_;
+  bool     advance_;                    ///< a ',' was seen; bump the index on the next element
+  bool     done_;
+};
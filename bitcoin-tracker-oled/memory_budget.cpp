@@ -0,0 +1,107 @@
+/**
+ * @file memory_budget.cpp
+ * @brief Compile-time RAM budget and its Serial report.
+ */
+
+#include "memory_budget.h"
+
+#include "api.h"
+#include "boot_cache.h"
+#include "candle_chart.h"
+#include "config.h"
+#include "connection.h"
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+  #include "display_lcd.h"
+#else
+  #include "display_oled.h"
+#endif
+#include "tick_history.h"
+#include "watchlist.h"
+
+// BearSSL record overhead on top of each I/O buffer (MAX_IN/OUT_OVERHEAD).
+#define TLS_READ_OVERHEAD  325
+#define TLS_WRITE_OVERHEAD 85
+
+// Engine, handshake and X.509 state of one BearSSL client (approximate).
+#define TLS_CLIENT_STATE   4096
+
+// The separate stack BearSSL runs on, allocated with the first client.
+#define TLS_STACK          6200
+
+// Open TLS sockets at worst: the stream runs beside the REST connection that
+// fetches the daily opens; the aggregator is plain HTTP.
+#if USE_AGGREGATOR
+  #define TLS_CONNECTIONS 0
+#elif USE_WEBSOCKET_STREAM
+  #define TLS_CONNECTIONS 2
+#else
+  #define TLS_CONNECTIONS 1
+#endif
+
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+  #define SCREEN_TYPE   LcdDisplay
+  #define FRAME_BUFFERS 0
+#else
+  #define SCREEN_TYPE   OledDisplay
+  // The library's framebuffer, and the copy of what the panel shows (display_utils.cpp)
+  #define FRAME_BUFFERS (2 * OLED_WIDTH * OLED_HEIGHT / 8)
+#endif
+
+struct BudgetItem {
+  char     name[16];
+  uint32_t bytes;
+};
+
+static constexpr uint32_t TLS_BUFFER_BYTES =
+    TLS_CONNECTIONS * (TLS_READ_BUFFER + TLS_READ_OVERHEAD + TLS_WRITE_BUFFER + TLS_WRITE_OVERHEAD);
+
+static constexpr uint32_t TLS_STATE_BYTES =
+    TLS_CONNECTIONS * TLS_CLIENT_STATE + (TLS_CONNECTIONS > 0 ? TLS_STACK : 0);
+
+static constexpr BudgetItem BUDGET[] PROGMEM = {
+  { "prices + opens",  2 * sizeof(price_t) * size_of_list_of_symbols },
+  { "tick history",    sizeof(TickHistory) * size_of_list_of_symbols },
+  { "candle chart",    sizeof(CandleChart) },
+  { "display",         sizeof(SCREEN_TYPE) },
+  { "frame buffers",   FRAME_BUFFERS },
+  { "http request",    CONN_REQUEST_BUFFER },
+  { "response parser", API_PARSE_BYTES },
+  { "tls buffers",     TLS_BUFFER_BYTES },
+  { "tls state",       TLS_STATE_BYTES },
+};
+
+#define BUDGET_ITEMS (sizeof(BUDGET) / sizeof(BUDGET[0]))
+
+constexpr uint32_t budget_total(size_t i = 0) {
+  return (i < BUDGET_ITEMS) ? BUDGET[i].bytes + budget_total(i + 1) : 0;
+}
+
+static constexpr uint32_t BUDGET_TOTAL = budget_total();
+
+static_assert(BUDGET_TOTAL <= RAM_BUDGET_BYTES,
+              "RAM plan exceeds RAM_BUDGET_BYTES: track fewer symbols, or reduce "
+              "TLS_READ_BUFFER/TLS_WRITE_BUFFER, CHART_CANDLES or TICK_HISTORY_BLOCKS");
+
+// The warm-boot snapshot is read onto the stack of setup()
+static_assert(sizeof(BootSnapshot) <= REQUEST_STACK_BYTES,
+              "list_of_symbols: the boot snapshot outgrows REQUEST_STACK_BYTES");
+
+/// "[memory] <name>  <bytes> B", without a line end; @p name_P in flash.
+static void print_line(Print& out, PGM_P name_P, uint32_t bytes) {
+  char name[sizeof(BUDGET[0].name)];
+  strlcpy_P(name, name_P, sizeof(name));
+  out.printf_P(PSTR("[memory] %-16s %6lu B"), name, (unsigned long)bytes);
+}
+
+void memory_budget_write(Print& out) {
+  for (size_t i = 0; i < BUDGET_ITEMS; i++) {
+    print_line(out, BUDGET[i].name, pgm_read_dword(&BUDGET[i].bytes));
+    out.println();
+  }
+  print_line(out, PSTR("total"), BUDGET_TOTAL);
+  out.print(F(" of "));
+  out.print(RAM_BUDGET_BYTES);
+  out.print(F(" B budget, "));
+  out.print(size_of_list_of_symbols);
+  out.println(F(" symbols"));
+}
@@ -0,0 +1,27 @@
+/**
+ * @file memory_budget.h
+ * @brief Static RAM plan of the sketch, checked against @c RAM_BUDGET_BYTES.
+ *
+ * Nearly all of the sketch's memory is claimed up front and has a size the
+ * compiler knows: the per-symbol state grows with @c list_of_symbols, the
+ * TLS connections with @c TLS_READ_BUFFER and @c TLS_WRITE_BUFFER.
+ * memory_budget.cpp adds these up and fails the build when they no longer
+ * fit @c RAM_BUDGET_BYTES, instead of leaving the shortfall to show up as a
+ * failed handshake at run time.  The TLS figures are estimates of what
+ * BearSSL allocates; the heap gauges of metrics.h show the real thing.
+ *
+ * Type @c memory in the Serial Monitor for the breakdown, e.g.
+ * @code
+ * [memory] prices + opens       32 B
+ * [memory] tick history       1312 B
+ * ...
+ * [memory] tls state         10296 B
+ * [memory] total             17674 B of 32768 B budget, 2 symbols
+ * @endcode
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/// Print one line per budget item, then the total against @c RAM_BUDGET_BYTES.
+void memory_budget_write(Print& out);
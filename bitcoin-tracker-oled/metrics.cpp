@@ -0,0 +1,217 @@
+/**
+ * @file metrics.cpp
+ * @brief Histogram storage, Prometheus text output and the /metrics listener.
+ */
+
+#include "metrics.h"
+
+#include <ESP8266WiFi.h>
+
+#include "config.h"
+#include "memory_budget.h"
+#include "price.h"      // format_fixed()
+
+// Bucket i counts samples ≤ 128 µs · 2^i; the last slot is +Inf.
+// 15 bounded buckets reach 2.1 s, enough for a slow TLS handshake.
+#define METRIC_BUCKETS      15
+#define METRIC_BUCKET_SHIFT 7
+
+// Longest wait for a scraper's request line once it has connected
+#define METRICS_HTTP_TIMEOUT_MS 200
+
+struct Histogram {
+  uint32_t counts[METRIC_BUCKETS + 1];
+  uint32_t count;
+  uint64_t sum_us;
+};
+
+static Histogram histograms[PHASE_COUNT];
+
+static const char PHASE_NAMES[PHASE_COUNT][8] PROGMEM = {
+  "dns", "connect", "ttfb", "parse", "render", "frame",
+};
+
+static uint32_t counters[COUNTER_COUNT];
+
+static const char COUNTER_NAMES[COUNTER_COUNT][28] PROGMEM = {
+  "anim_frames_drawn_total", "anim_frames_dropped_total",
+};
+
+static const char COUNTER_HELP[COUNTER_COUNT][48] PROGMEM = {
+  "Price tick animation frames drawn",
+  "Animation frames skipped, the loop was busy",
+};
+
+// Gauges
+static uint32_t heap_free      = 0;
+static uint32_t heap_free_min  = UINT32_MAX;
+static uint32_t heap_max_block = 0;
+static uint8_t  heap_frag      = 0;
+static uint8_t  heap_frag_max  = 0;
+
+static WiFiServer server(METRICS_HTTP_PORT);
+
+// Serial command line
+static char    command[16];
+static uint8_t command_len = 0;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Recording
+// ─────────────────────────────────────────────────────────────────────────────
+
+void metrics_record(MetricPhase phase, uint32_t us) {
+  uint32_t scaled = (us == 0) ? 0 : (us - 1) >> METRIC_BUCKET_SHIFT;
+  uint8_t  bucket = (scaled == 0) ? 0 : 32 - __builtin_clz(scaled);
+  if (bucket > METRIC_BUCKETS) bucket = METRIC_BUCKETS;
+
+  Histogram& h = histograms[phase];
+  h.counts[bucket]++;
+  h.count++;
+  h.sum_us += us;
+}
+
+void metrics_count(MetricCounter counter, uint32_t n) {
+  counters[counter] += n;
+}
+
+void metrics_sample_heap() {
+  heap_free      = ESP.getFreeHeap();
+  heap_max_block = ESP.getMaxFreeBlockSize();
+  heap_frag      = ESP.getHeapFragmentation();
+  if (heap_free < heap_free_min) heap_free_min = heap_free;
+  if (heap_frag > heap_frag_max) heap_frag_max = heap_frag;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Output
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Print @p us as seconds with microsecond precision, e.g. "0.000128".
+static void print_seconds(Print& out, uint64_t us) {
+  char text[24];
+  format_fixed(text, us, 6);
+  out.print(text);
+}
+
+/// One gauge or counter: HELP and TYPE lines, then its value.
+static void print_metric(Print& out, PGM_P name_P, PGM_P help_P,
+                         const __FlashStringHelper* type, uint32_t value) {
+  out.print(F("# HELP tracker_"));
+  out.print(FPSTR(name_P));
+  out.print(' ');
+  out.println(FPSTR(help_P));
+  out.print(F("# TYPE tracker_"));
+  out.print(FPSTR(name_P));
+  out.print(' ');
+  out.println(type);
+  out.print(F("tracker_"));
+  out.print(FPSTR(name_P));
+  out.print(' ');
+  out.println(value);
+}
+
+static void print_gauge(Print& out, PGM_P name_P, PGM_P help_P, uint32_t value) {
+  print_metric(out, name_P, help_P, F("gauge"), value);
+}
+
+/// Start of a per-phase sample line: `tracker_phase_duration_seconds<suffix>{phase="<name>"`.
+static void print_series(Print& out, const __FlashStringHelper* suffix, uint8_t phase) {
+  out.print(F("tracker_phase_duration_seconds"));
+  out.print(suffix);
+  out.print(F("{phase=\""));
+  out.print(FPSTR(PHASE_NAMES[phase]));
+  out.print('"');
+}
+
+void metrics_write(Print& out) {
+  out.println(F("# HELP tracker_phase_duration_seconds Duration of each poll-cycle phase"));
+  out.println(F("# TYPE tracker_phase_duration_seconds histogram"));
+
+  for (uint8_t p = 0; p < PHASE_COUNT; p++) {
+    const Histogram& h = histograms[p];
+    uint32_t cumulative = 0;
+
+    for (uint8_t b = 0; b <= METRIC_BUCKETS; b++) {
+      cumulative += h.counts[b];
+      print_series(out, F("_bucket"), p);
+      out.print(F(",le=\""));
+      if (b < METRIC_BUCKETS) print_seconds(out, (uint64_t)1 << (b + METRIC_BUCKET_SHIFT));
+      else                    out.print(F("+Inf"));
+      out.print(F("\"} "));
+      out.println(cumulative);
+    }
+    print_series(out, F("_sum"), p);
+    out.print(F("} "));
+    print_seconds(out, h.sum_us);
+    out.println();
+    print_series(out, F("_count"), p);
+    out.print(F("} "));
+    out.println(h.count);
+  }
+
+  for (uint8_t c = 0; c < COUNTER_COUNT; c++) {
+    print_metric(out, COUNTER_NAMES[c], COUNTER_HELP[c], F("counter"), counters[c]);
+  }
+
+  metrics_sample_heap();
+  print_gauge(out, PSTR("heap_free_bytes"),      PSTR("Free heap now"),            heap_free);
+  print_gauge(out, PSTR("heap_free_min_bytes"),  PSTR("Lowest free heap sampled"), heap_free_min);
+  print_gauge(out, PSTR("heap_max_block_bytes"), PSTR("Largest allocatable block now"),
+              heap_max_block);
+  print_gauge(out, PSTR("heap_fragmentation_percent"), PSTR("Heap fragmentation now"),
+              heap_frag);
+  print_gauge(out, PSTR("heap_fragmentation_max_percent"), PSTR("Highest fragmentation sampled"),
+              heap_frag_max);
+  print_gauge(out, PSTR("stack_free_min_bytes"), PSTR("Stack high-water mark (least ever free)"),
+              ESP.getFreeContStack());
+  print_gauge(out, PSTR("uptime_seconds"), PSTR("Seconds since boot"), millis() / 1000);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Transports
+// ─────────────────────────────────────────────────────────────────────────────
+
+void metrics_http_begin() {
+  if (METRICS_HTTP_PORT != 0) server.begin();
+}
+
+/// Answer one scraper, if one is waiting.
+static void serve_http() {
+  WiFiClient client = server.accept();
+  if (!client) return;
+
+  char line[48];
+  client.setTimeout(METRICS_HTTP_TIMEOUT_MS);
+  size_t n = client.readBytesUntil('\n', line, sizeof(line) - 1);
+  line[n] = '\0';
+
+  if (strncmp_P(line, PSTR("GET /metrics "), 13) == 0) {
+    client.print(F("HTTP/1.0 200 OK\r\n"
+                   "Content-Type: text/plain; version=0.0.4\r\n"
+                   "Connection: close\r\n\r\n"));
+    metrics_write(client);
+  } else {
+    client.print(F("HTTP/1.0 404 Not Found\r\nConnection: close\r\n\r\n"));
+  }
+  client.stop();
+}
+
+/// Collect a Serial line; "stats" dumps the metrics, "memory" the RAM plan.
+static void serve_serial() {
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+    if (c != '\n' && c != '\r') {
+      if (command_len < sizeof(command) - 1) command[command_len++] = c;
+      continue;
+    }
+    command[command_len] = '\0';
+    if (strcmp_P(command, PSTR("stats")) == 0) metrics_write(Serial);
+    else if (strcmp_P(command, PSTR("memory")) == 0) memory_budget_write(Serial);
+    command_len = 0;
+  }
+}
+
+void metrics_poll() {
+  if (METRICS_HTTP_PORT != 0) serve_http();
+  serve_serial();
+}
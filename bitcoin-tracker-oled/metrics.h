@@ -0,0 +1,63 @@
+/**
+ * @file metrics.h
+ * @brief Always-on timing histograms and heap gauges, exposed over Serial and HTTP.
+ *
+ * Each phase of a poll cycle (DNS lookup, connect, time to first byte,
+ * parse, render), and each animation frame, is recorded into a fixed
+ * histogram of power-of-two microsecond buckets.  Recording is a micros()
+ * difference, a count-leading-zeros and two additions, so it stays enabled
+ * in release builds.  Heap and stack gauges are sampled periodically.
+ *
+ * The data can be read in two ways:
+ *  - type @c stats in the Serial Monitor
+ *  - scrape @c http://<device-ip>/metrics (Prometheus text format), e.g.
+ * @code
+ * tracker_phase_duration_seconds_bucket{phase="ttfb",le="0.131072"} 412
+ * tracker_phase_duration_seconds_sum{phase="ttfb"} 38.112064
+ * tracker_phase_duration_seconds_count{phase="ttfb"} 415
+ * tracker_heap_free_min_bytes 17224
+ * @endcode
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/// Timed phases; the order matches the names in metrics.cpp.
+enum MetricPhase : uint8_t {
+  PHASE_DNS,        ///< host name lookup
+  PHASE_CONNECT,    ///< TCP probe, then TCP connect + TLS handshake (one call in BearSSL)
+  PHASE_TTFB,       ///< request written → first response byte seen by conn_poll()
+  PHASE_PARSE,      ///< response body scanned into the price arrays
+  PHASE_RENDER,     ///< frame drawn and flushed to the OLED
+  PHASE_FRAME,      ///< one price tick animation frame blitted and flushed
+  PHASE_COUNT
+};
+
+/// Event counters; the order matches the names in metrics.cpp.
+enum MetricCounter : uint8_t {
+  COUNTER_FRAMES_DRAWN,     ///< animation frames drawn
+  COUNTER_FRAMES_DROPPED,   ///< animation frames skipped because the loop was busy
+  COUNTER_COUNT
+};
+
+/// Add one duration sample, in microseconds.
+void metrics_record(MetricPhase phase, uint32_t us);
+
+/// Add @p n to @p counter.
+void metrics_count(MetricCounter counter, uint32_t n = 1);
+
+/// Update the heap and stack gauges (free, low-water, fragmentation).
+void metrics_sample_heap();
+
+/// Write every metric in Prometheus text exposition format.
+void metrics_write(Print& out);
+
+/// Start the /metrics HTTP listener (no-op when METRICS_HTTP_PORT is 0).
+void metrics_http_begin();
+
+/**
+ * @brief Serve at most one pending /metrics request and check Serial for
+ *        the @c stats and @c memory (memory_budget.h) commands.  Call
+ *        periodically from a scheduler task.
+ */
+void metrics_poll();
@@ -0,0 +1,65 @@
+/**
+ * @file poll_planner.cpp
+ * @brief Adaptive poll interval, rotation prefetch and request-weight budget.
+ */
+
+#include "poll_planner.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// RequestBudget
+// ─────────────────────────────────────────────────────────────────────────────
+
+void RequestBudget::refill(unsigned long now_ms) {
+  if (!started_) {
+    last_ms_ = now_ms;
+    started_ = true;
+    return;
+  }
+  // per_minute_ weight per 60 000 ms = per_minute_ / 60 milli-tokens per ms
+  uint64_t elapsed = now_ms - last_ms_;
+  uint64_t tokens  = milli_tokens_ + elapsed * per_minute_ / 60;
+  uint32_t full    = per_minute_ * 1000UL;
+  milli_tokens_    = (tokens > full) ? full : (uint32_t)tokens;
+  last_ms_         = now_ms;
+}
+
+bool RequestBudget::try_spend(uint16_t weight, unsigned long now_ms) {
+  refill(now_ms);
+  uint32_t cost = weight * 1000UL;
+  if (milli_tokens_ < cost) return false;
+  milli_tokens_ -= cost;
+  return true;
+}
+
+unsigned long RequestBudget::wait_ms(uint16_t weight, unsigned long now_ms) {
+  refill(now_ms);
+  uint32_t cost = weight * 1000UL;
+  if (milli_tokens_ >= cost || per_minute_ == 0) return 0;
+  // Round up so the retry does not land a millisecond short
+  return ((cost - milli_tokens_) * 60UL + per_minute_ - 1) / per_minute_;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// PollPlanner
+// ─────────────────────────────────────────────────────────────────────────────
+
+void PollPlanner::on_prices(bool visible_changed) {
+  if (visible_changed) {
+    interval_ms_ = min_ms_;
+  } else if (interval_ms_ < max_ms_) {
+    interval_ms_ = (interval_ms_ * 2 > max_ms_) ? max_ms_ : interval_ms_ * 2;
+  }
+}
+
+unsigned long PollPlanner::next_delay(unsigned long until_rotate_ms) const {
+  unsigned long delay_ms = interval_ms_;
+
+  // A rotation comes before the regular poll would: prefetch so the batch
+  // lands just ahead of it.  Closer than the lead, the batch that was just
+  // received is already fresh enough.
+  if (until_rotate_ms != POLL_NO_ROTATION && until_rotate_ms > lead_ms_
+      && until_rotate_ms - lead_ms_ < delay_ms) {
+    delay_ms = until_rotate_ms - lead_ms_;
+  }
+  return delay_ms;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file poll_planner.h
+ * @brief Decides when the next batched price poll goes out.
+ *
+ * One request refreshes every symbol (api.h), so planning is about timing
+ * rather than picking symbols:
+ *  - the visible symbol is polled at @c poll_delay while it is moving; each
+ *    response where it did not move doubles the interval, up to
+ *    @c POLL_IDLE_MAX_MS
+ *  - a poll is pulled forward to land @c PREFETCH_LEAD_MS before the next
+ *    rotation, so the symbol rotated in is drawn from a fresh batch
+ *  - every request spends Binance request weight from a per-minute budget
+ *    (@c REQUEST_WEIGHT_PER_MINUTE) and waits when it would overdraw it
+ *
+ * Like UtcClock, nothing here reads millis(): the caller passes the current
+ * time in, so the planner can be driven from a simulated clock on a host.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Token bucket of Binance request weight, refilled continuously.
+ *
+ * Starts full, so the first requests after boot are never held back.
+ */
+class RequestBudget {
+ public:
+  explicit RequestBudget(uint16_t weight_per_minute)
+      : per_minute_(weight_per_minute), milli_tokens_(weight_per_minute * 1000UL) {}
+
+  /// Spend @p weight if the budget allows it at @p now_ms.
+  bool try_spend(uint16_t weight, unsigned long now_ms);
+
+  /// How long until @p weight can be spent (0 if it already can).
+  unsigned long wait_ms(uint16_t weight, unsigned long now_ms);
+
+ private:
+  void refill(unsigned long now_ms);
+
+  uint16_t      per_minute_;
+  uint32_t      milli_tokens_;       ///< weight × 1000, so refill needs no float
+  unsigned long last_ms_ = 0;
+  bool          started_ = false;
+};
+
+/// next_delay() argument when there is no rotation to prefetch for.
+#define POLL_NO_ROTATION 0xFFFFFFFFUL
+
+class PollPlanner {
+ public:
+  PollPlanner(unsigned long min_ms, unsigned long max_ms, unsigned long lead_ms)
+      : min_ms_(min_ms), max_ms_(max_ms), lead_ms_(lead_ms), interval_ms_(min_ms) {}
+
+  /// A price batch arrived; @p visible_changed says whether the shown symbol moved.
+  void on_prices(bool visible_changed);
+
+  /// A different symbol is now visible: poll it at full rate again.
+  void on_rotate() { interval_ms_ = min_ms_; }
+
+  /**
+   * @brief Delay before the next price poll.
+   * @param until_rotate_ms  Time until the next symbol rotation, or
+   *                         @c POLL_NO_ROTATION when there is none.
+   */
+  unsigned long next_delay(unsigned long until_rotate_ms) const;
+
+  /// Current interval while no rotation is near.
+  unsigned long interval() const { return interval_ms_; }
+
+ private:
+  unsigned long min_ms_;
+  unsigned long max_ms_;
+  unsigned long lead_ms_;
+  unsigned long interval_ms_;
+};
@@ -0,0 +1,89 @@
+/**
+ * @file price.cpp
+ * @brief Fixed-point price implementation.
+ */
+
+#include "price.h"
+
+// 10^n for n = 0..8, the only powers the formatting helpers need.
+static const uint32_t POW10[] PROGMEM = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+};
+
+static uint32_t pow10_u32(uint8_t n) {
+  return pgm_read_dword(&POW10[n]);
+}
+
+// Largest integer part whose price_t, fractional digits included, fits in int64_t
+#define PRICE_MAX_WHOLE ((INT64_MAX - (PRICE_SCALE - 1)) / PRICE_SCALE)
+
+price_t price_parse(const char* text) {
+  if (text == nullptr || *text == '\0') return -1;
+
+  price_t whole = 0;
+  const char* p = text;
+  for (; *p >= '0' && *p <= '9'; p++) {
+    whole = whole * 10 + (*p - '0');
+    if (whole > PRICE_MAX_WHOLE) return -1;  // would overflow price_t
+  }
+  if (p == text) return -1;                  // no integer digits
+
+  price_t frac   = 0;
+  uint8_t digits = 0;
+  if (*p == '.') {
+    for (p++; *p >= '0' && *p <= '9'; p++) {
+      if (digits < PRICE_DECIMALS) {
+        frac = frac * 10 + (*p - '0');
+        digits++;
+      }
+    }
+  }
+  if (*p != '\0') return -1;
+
+  return whole * PRICE_SCALE + frac * pow10_u32(PRICE_DECIMALS - digits);
+}
+
+size_t format_fixed(char* out, uint64_t value, uint8_t decimals) {
+  // Build the digits backwards, then copy them out in order
+  char   tmp[PRICE_TEXT_SIZE];
+  size_t n = 0;
+
+  for (uint8_t i = 0; i < decimals; i++) {
+    tmp[n++] = '0' + (value % 10);
+    value /= 10;
+  }
+  if (decimals > 0) tmp[n++] = '.';
+  do {
+    tmp[n++] = '0' + (value % 10);
+    value /= 10;
+  } while (value > 0 && n < sizeof(tmp));
+
+  for (size_t i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+  out[n] = '\0';
+  return n;
+}
+
+size_t price_format(char* out, price_t price, uint8_t decimals) {
+  if (price < 0) price = 0;
+  if (decimals > PRICE_DECIMALS) decimals = PRICE_DECIMALS;
+
+  uint32_t unit    = pow10_u32(PRICE_DECIMALS - decimals);
+  uint64_t rounded = ((uint64_t)price + unit / 2) / unit;
+  return format_fixed(out, rounded, decimals);
+}
+
+uint32_t price_change_pct(price_t current, price_t reference, uint8_t decimals) {
+  if (reference <= 0) return 0;
+
+  uint64_t diff  = (current >= reference) ? current - reference : reference - current;
+  uint64_t scale = 100ULL * pow10_u32(decimals);
+  return (uint32_t)((diff * scale + (uint64_t)reference / 2) / (uint64_t)reference);
+}
+
+int price_change_cmp(price_t current, price_t reference, int32_t pct_tenths) {
+  // (current − reference) / reference  vs  pct_tenths / 1000
+  // ⇔ (current − reference) · 1000  vs  reference · pct_tenths   (reference > 0)
+  int64_t lhs = (current - reference) * 1000;
+  int64_t rhs = reference * (int64_t)pct_tenths;
+  return (lhs > rhs) - (lhs < rhs);
+}
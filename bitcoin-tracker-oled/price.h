@@ -0,0 +1,78 @@
+/**
+ * @file price.h
+ * @brief Fixed-point price representation and formatting.
+ *
+ * The ESP8266 has no FPU, so every double operation is a soft-float library
+ * call.  Binance quotes prices as decimal strings with at most 8 fractional
+ * digits, which map exactly onto a 64-bit integer count of 1e-8 units:
+ * @c "60950.01000000" → @c 6095001000000.  Parsing, comparison, % change and
+ * formatting are all done in integer arithmetic, with no rounding error.
+ *
+ * Range: up to ~92 billion dollars per unit, far beyond any quoted price.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+/// Price in units of 1e-8 (Binance's finest quote precision).
+typedef int64_t price_t;
+
+#define PRICE_DECIMALS 8
+#define PRICE_SCALE    100000000LL
+
+/// Whole dollars → price_t, for readable range constants (e.g. PRICE_UNITS(1000)).
+#define PRICE_UNITS(n) ((price_t)(n) * PRICE_SCALE)
+
+/// Largest text produced by the format helpers, including the terminator.
+#define PRICE_TEXT_SIZE 24
+
+/**
+ * @brief Parse a Binance decimal string ("60950.01000000") into a price_t.
+ *
+ * Fractional digits beyond the 8th are truncated.  Leading/trailing junk is
+ * rejected, and so is an integer part too large for price_t, so a truncated
+ * or malformed value never becomes a wrong price.
+ *
+ * @return The price, or -1 if @p text is not a plain non-negative decimal.
+ */
+price_t price_parse(const char* text);
+
+/**
+ * @brief Format a non-negative fixed-point value with @p decimals digits.
+ *
+ * @p value is an integer count of 10^-decimals units, so
+ * format_fixed(out, 1234, 2) writes "12.34".  No rounding happens here.
+ *
+ * @param out  Buffer of at least PRICE_TEXT_SIZE bytes.
+ * @return Length of the text written.
+ */
+size_t format_fixed(char* out, uint64_t value, uint8_t decimals);
+
+/**
+ * @brief Format @p price rounded half-up to @p decimals fractional digits.
+ *
+ * price_format(out, PRICE_UNITS(1) / 3, 4) writes "0.3333".
+ *
+ * @param out  Buffer of at least PRICE_TEXT_SIZE bytes.
+ * @return Length of the text written.
+ */
+size_t price_format(char* out, price_t price, uint8_t decimals);
+
+/**
+ * @brief |current − reference| / reference as a percentage, rounded half-up.
+ *
+ * @param decimals  Fractional digits of the result, 0–2.
+ * @return The percentage in units of 10^-decimals (so with decimals = 2,
+ *         3.5 % is 350), or 0 if @p reference is not positive.
+ */
+uint32_t price_change_pct(price_t current, price_t reference, uint8_t decimals);
+
+/**
+ * @brief Compare (current − reference) / reference against @p pct_tenths / 10 %.
+ *
+ * Exact sign test used for threshold checks such as "change ≥ +3.5 %"
+ * (@p pct_tenths = 35) without computing the ratio.
+ *
+ * @return Negative, zero or positive like strcmp().
+ */
+int price_change_cmp(price_t current, price_t reference, int32_t pct_tenths);
@@ -0,0 +1,179 @@
+/**
+ * @file price_anim.cpp
+ * @brief Digit roll and inverse flash, blitted into the SH1106 framebuffer.
+ */
+
+#include "config.h"
+
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_OLED
+
+#include "price_anim.h"
+
+#include <Adafruit_GFX.h>
+
+#include "display_utils.h"
+
+// Gap between the outgoing and incoming glyph while rolling, in font rows.
+#define ANIM_ROLL_GAP 1
+
+/// Glyph cache slot of @p c, or -1 if it cannot roll.
+static int8_t glyph_index(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c == '.')             return 10;
+  return -1;
+}
+
+/// Rows [@p top, @p top + @p rows) of a screen column.
+static uint64_t row_mask(int16_t top, uint8_t rows) {
+  return (((uint64_t)1 << rows) - 1) << top;
+}
+
+/// Glyph column @p bits with its first row at screen row @p y (may be off-screen).
+static uint64_t place(uint32_t bits, int16_t y) {
+  if (y <= -32 || y >= OLED_HEIGHT) return 0;
+  return (y >= 0) ? (uint64_t)bits << y : (uint64_t)(bits >> -y);
+}
+
+/// Replace the @p mask rows of column @p x with @p bits (page layout: 8 rows per byte).
+static void write_column(uint8_t* buffer, int16_t x, uint64_t bits, uint64_t mask) {
+  for (uint8_t page = 0; page < OLED_HEIGHT / 8; page++) {
+    uint8_t m = (uint8_t)(mask >> (page * 8));
+    if (m == 0) continue;
+    uint8_t& b = buffer[page * OLED_WIDTH + x];
+    b = (b & ~m) | ((uint8_t)(bits >> (page * 8)) & m);
+  }
+}
+
+void PriceAnimation::begin() {
+  // Sample the library's own glyphs so the last stage matches print() exactly
+  GFXcanvas1 canvas(ANIM_FONT_COLUMNS * 3, 8 * 3);
+  for (uint8_t g = 0; g < ANIM_GLYPHS; g++) {
+    char c = (g < 10) ? '0' + g : '.';
+    for (uint8_t size = 2; size <= 3; size++) {
+      uint32_t* columns = (size == 3) ? large_[g] : small_[g];
+      canvas.fillScreen(0);
+      canvas.drawChar(0, 0, c, 1, 1, size);
+      for (uint8_t col = 0; col < ANIM_FONT_COLUMNS; col++) {
+        uint32_t bits = 0;
+        for (uint8_t row = 0; row < 7 * size; row++) {
+          if (canvas.getPixel(col * size, row)) bits |= (uint32_t)1 << row;
+        }
+        columns[col] = bits;
+      }
+    }
+  }
+}
+
+void PriceAnimation::layout(price_t price, char* text, Span* spans, uint8_t* count) const {
+  PriceLayout at = price_layout(price, text);
+  spans[0] = { at.x, 4, 3, 0, at.large };
+  *count   = 1;
+  if (at.small > 0) {
+    spans[1] = { at.small_x, 11, 2, at.large, (uint8_t)(at.large + at.small) };
+    *count   = 2;
+  }
+}
+
+void PriceAnimation::start(price_t from, price_t to, unsigned long now_ms) {
+  Span    from_spans[2];
+  uint8_t from_count;
+  layout(from, from_, from_spans, &from_count);
+  layout(to,   to_,   spans_,     &span_count_);
+
+  dir_      = (to > from) ? 1 : -1;
+  flash_    = last_dir_ != 0 && dir_ != last_dir_;
+  last_dir_ = dir_;
+
+  // Rolling needs every cell in the same place, and glyphs for the changed ones
+  uint8_t changed = 0;
+  roll_ = from_count == span_count_;
+  for (uint8_t s = 0; roll_ && s < span_count_; s++) {
+    const Span& a = from_spans[s];
+    const Span& b = spans_[s];
+    roll_ = a.x == b.x && a.first == b.first && a.end == b.end;
+    for (uint8_t i = b.first; roll_ && i < b.end; i++) {
+      if (from_[i] == to_[i]) continue;
+      roll_ = glyph_index(from_[i]) >= 0 && glyph_index(to_[i]) >= 0;
+      changed++;
+    }
+  }
+  if (!roll_) {
+    flash_ = true;
+  } else if (changed == 0) {
+    active_ = false;                        // the change is below the digits shown
+    return;
+  }
+
+  inverted_ = false;
+  start_ms_ = now_ms;
+  active_   = true;
+}
+
+void PriceAnimation::draw_cell(uint8_t* buffer, const Span& span, uint8_t i,
+                               int16_t offset, bool invert) const {
+  const uint32_t* in  = (span.size == 3 ? large_ : small_)[glyph_index(to_[i])];
+  const uint32_t* out = (span.size == 3 ? large_ : small_)[glyph_index(from_[i])];
+  uint8_t  rows  = 7 * span.size;
+  uint8_t  pitch = 6 * span.size;
+  uint64_t clip  = row_mask(span.top, rows);
+
+  // Rising: the new glyph comes up from below and pushes the old one out the top
+  int16_t in_y  = span.top + dir_ * offset;
+  int16_t out_y = in_y - dir_ * (rows + ANIM_ROLL_GAP * span.size);
+
+  int16_t x = span.x + (i - span.first) * pitch;
+  for (uint8_t col = 0; col < ANIM_FONT_COLUMNS * span.size; col++, x++) {
+    if (x < 0 || x >= OLED_WIDTH) continue;
+    uint8_t  c    = col / span.size;
+    uint64_t bits = (place(in[c], in_y) | place(out[c], out_y)) & clip;
+    if (invert) bits ^= clip;
+    write_column(buffer, x, bits, clip);
+  }
+}
+
+void PriceAnimation::invert_spans(uint8_t* buffer) const {
+  int16_t left = 0;
+  for (uint8_t s = 0; s < span_count_; s++) {
+    const Span& span  = spans_[s];
+    uint64_t    clip  = row_mask(span.top, 7 * span.size);
+    int16_t     right = span.x + (span.end - span.first) * 6 * span.size - span.size;
+    // The decimals start inside the last large cell: invert those columns once
+    if (span.x > left) left = span.x;
+    for (int16_t x = left; x < right && x < OLED_WIDTH; x++) {
+      if (x < 0) continue;
+      for (uint8_t page = 0; page < OLED_HEIGHT / 8; page++) {
+        buffer[page * OLED_WIDTH + x] ^= (uint8_t)(clip >> (page * 8));
+      }
+    }
+    left = right;
+  }
+}
+
+void PriceAnimation::frame(uint8_t* buffer, unsigned long now_ms) {
+  if (!active_) return;
+
+  unsigned long elapsed = now_ms - start_ms_;
+  unsigned long length  = roll_ ? ANIM_ROLL_MS : 0;
+  if (flash_ && ANIM_FLASH_MS > length) length = ANIM_FLASH_MS;
+  bool flash = flash_ && elapsed < ANIM_FLASH_MS;
+
+  if (roll_) {
+    // Ease out: fast at first, settling into place
+    uint32_t left = (elapsed < ANIM_ROLL_MS) ? ANIM_ROLL_MS - elapsed : 0;
+    for (uint8_t s = 0; s < span_count_; s++) {
+      const Span& span   = spans_[s];
+      uint32_t    travel = (7 + ANIM_ROLL_GAP) * span.size;
+      int16_t     offset = travel * left * left / ((uint32_t)ANIM_ROLL_MS * ANIM_ROLL_MS);
+      for (uint8_t i = span.first; i < span.end; i++) {
+        if (from_[i] != to_[i]) draw_cell(buffer, span, i, offset, flash);
+      }
+    }
+  } else if (flash != inverted_) {
+    invert_spans(buffer);
+    inverted_ = flash;
+  }
+
+  if (elapsed >= length) active_ = false;
+}
+
+#endif // DISPLAY_BACKEND == DISPLAY_BACKEND_OLED
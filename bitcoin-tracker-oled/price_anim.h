@@ -0,0 +1,96 @@
+/**
+ * @file price_anim.h
+ * @brief Frame-paced price tick transitions on the OLED: digit roll and inverse flash.
+ *
+ * When the price on screen ticks, the frame with the new price is composed
+ * as usual (display_utils.h); each frame of the transition then rewrites
+ * only the character cells whose digit changed:
+ *  - roll:  the old digit slides out and the new one in — upwards on a rise,
+ *           downwards on a fall — easing out over @c ANIM_ROLL_MS;
+ *  - flash: on a tick against the direction of the one before, the changed
+ *           cells are drawn inverted for the first @c ANIM_FLASH_MS.
+ * When the old and new price are laid out differently (e.g. $9 999.99 →
+ * $10 000.00) there is nothing to roll, and the whole number flashes instead.
+ *
+ * Cells are written straight into the SH1106 framebuffer from glyph columns
+ * rendered once by begin(): a column of the screen is a 64-bit word, so
+ * sliding a glyph is a shift and clipping it to its cell is a mask.  No text
+ * is laid out per frame.
+ *
+ * Each frame is a function of the time since the tick, not of how many
+ * frames came before: a frame that runs late (a blocking network read, a
+ * slow flush) shows a later stage, and the transition still ends on time.
+ *
+ * OLED builds only (@c DISPLAY_BACKEND_OLED).
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "config.h"
+#include "price.h"
+
+/// Glyphs that can roll: '0'–'9' and '.'.
+#define ANIM_GLYPHS 11
+
+/// Columns of one font glyph before scaling (Adafruit GFX classic 5×7 font).
+#define ANIM_FONT_COLUMNS 5
+
+class PriceAnimation {
+ public:
+  /// Render the glyph cache.  Call once, before the first start().
+  void begin();
+
+  /**
+   * @brief Start the transition from @p from to @p to.
+   *
+   * The screen for @p to must already be composed in the framebuffer; draw
+   * the first stage over it with frame() before flushing.
+   */
+  void start(price_t from, price_t to, unsigned long now_ms);
+
+  /// Abandon the transition, e.g. because another screen was drawn.
+  void stop() { active_ = false; }
+
+  /// True until the last stage has been drawn.
+  bool active() const { return active_; }
+
+  /**
+   * @brief Draw the stage at @p now_ms into @p buffer.
+   *
+   * @param buffer  SH1106 framebuffer (Adafruit_SH1106G::getBuffer()).
+   *
+   * The last stage leaves exactly the composed frame and ends the transition.
+   */
+  void frame(uint8_t* buffer, unsigned long now_ms);
+
+ private:
+  /// A run of characters in one text size, as laid out by the price screen.
+  struct Span {
+    int16_t x;                         ///< left edge of the first cell
+    int16_t top;                       ///< first pixel row of the glyphs
+    uint8_t size;                      ///< GFX text size: 3 or 2
+    uint8_t first;                     ///< index of the first character in the text
+    uint8_t end;                       ///< one past the last character
+  };
+
+  void layout(price_t price, char* text, Span* spans, uint8_t* count) const;
+  void draw_cell(uint8_t* buffer, const Span& span, uint8_t i, int16_t offset, bool invert) const;
+  void invert_spans(uint8_t* buffer) const;
+
+  /// Columns of each glyph at sizes 3 and 2, bit r = pixel row r.
+  uint32_t large_[ANIM_GLYPHS][ANIM_FONT_COLUMNS];
+  uint32_t small_[ANIM_GLYPHS][ANIM_FONT_COLUMNS];
+
+  char          from_[PRICE_TEXT_SIZE];
+  char          to_[PRICE_TEXT_SIZE];
+  Span          spans_[2];
+  uint8_t       span_count_ = 0;
+  unsigned long start_ms_   = 0;
+  int8_t        dir_        = 0;       ///< +1 rise, −1 fall
+  int8_t        last_dir_   = 0;       ///< direction of the previous tick
+  bool          roll_       = false;   ///< same layout: roll the changed cells
+  bool          flash_      = false;
+  bool          inverted_   = false;   ///< the whole number is inverted now (no roll)
+  bool          active_     = false;
+};
@@ -0,0 +1,383 @@
+/**
+ * @file price_stream.cpp
+ * @brief Binance WebSocket miniTicker stream implementation.
+ *
+ * Three small layers, all driven one byte at a time so a frame can arrive
+ * split across any number of price_stream_poll() calls:
+ *  - connection: TLS socket + HTTP Upgrade handshake, whose response is
+ *    read as it arrives, and reconnect with back-off
+ *  - frame decoder: RFC 6455 header/payload state machine, answers pings
+ *  - message scanner: feeds text messages through JsonScanner and picks
+ *    out the "s", "c" and "o" values, committing them when a message ends
+ */
+
+#include "price_stream.h"
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+
+#include "api.h"
+#include "config.h"
+#include "debug.h"
+#include "json_scanner.h"
+#include "watchlist.h"
+
+// miniTicker pushes every second; this long without a byte means the socket
+// is dead even if TCP has not noticed yet.
+#define STREAM_SILENCE_MS      30000
+#define STREAM_BACKOFF_MIN_MS  1000
+#define STREAM_BACKOFF_MAX_MS  30000
+#define STREAM_TIMEOUT_MS      5000
+
+// Cap per poll so a burst of frames cannot starve the other tasks.
+#define STREAM_MAX_BYTES_PER_POLL 512
+
+// Upgrade request: the request line, then headers taking up to this much.
+#define STREAM_REQUEST_HEADERS 192
+
+#define WS_OP_CONTINUATION 0x0
+#define WS_OP_TEXT         0x1
+#define WS_OP_CLOSE        0x8
+#define WS_OP_PING         0x9
+#define WS_OP_PONG         0xA
+
+// "GET /stream?streams=btcusdt@miniTicker/ethusdt@miniTicker", built in flash
+static constexpr WatchlistJoin JOIN_STREAMS = {
+  "GET /stream?streams=", "", "usdt@miniTicker", "/", "", true,
+};
+WATCHLIST_TEXT(STREAM_REQUEST_LINE, JOIN_STREAMS);
+
+#define STREAM_REQUEST_BUFFER (sizeof(STREAM_REQUEST_LINE) + STREAM_REQUEST_HEADERS)
+
+static_assert(STREAM_REQUEST_BUFFER <= REQUEST_STACK_BYTES,
+              "list_of_symbols: the stream upgrade request outgrows REQUEST_STACK_BYTES");
+
+// ─────────────────────────────────────────────────────────────────────────────
+// State
+// ─────────────────────────────────────────────────────────────────────────────
+
+static WiFiClientSecure client;
+static bool          configured    = false;
+static bool          connected     = false;   // TLS socket open
+static bool          upgraded      = false;   // 101 response and its headers read
+static unsigned long upgrade_start = 0;
+static unsigned long last_data     = 0;
+static unsigned long next_attempt  = 0;
+static unsigned long backoff_ms    = STREAM_BACKOFF_MIN_MS;
+
+// Output targets and change counter for the poll in progress
+static price_t* out_prices = nullptr;
+static price_t* out_opens  = nullptr;
+static int     changed    = 0;
+
+// Upgrade response: the line being read, and whether the status line is in
+static char    upgrade_line[64];
+static uint8_t upgrade_len    = 0;
+static bool    upgrade_status = false;
+
+// Frame decoder
+static uint8_t  header[14];
+static uint8_t  header_len     = 0;
+static uint8_t  header_need    = 2;
+static bool     in_payload     = false;
+static bool     frame_fin      = false;
+static uint8_t  frame_opcode   = 0;
+static uint8_t  message_opcode = 0;    // opcode of the (possibly fragmented) data message
+static uint32_t payload_left   = 0;
+static uint8_t  control[125];          // control frame payloads are ≤ 125 bytes
+static uint8_t  control_len    = 0;
+
+// Message scanner plus the values picked out of the current text message
+static JsonScanner json;
+static char        message_symbol[16];
+static price_t     message_close = -1;
+static price_t     message_open  = -1;
+
+static const char KEY_S[] PROGMEM = "s";
+static const char KEY_C[] PROGMEM = "c";
+static const char KEY_O[] PROGMEM = "o";
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Message scanning
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void message_reset() {
+  json.reset();
+  message_symbol[0] = '\0';
+  message_close     = -1;
+  message_open      = -1;
+}
+
+/**
+ * @brief Feed one byte of a text message.
+ *
+ * The miniTicker fields sit inside the combined-stream envelope
+ * (@c {"stream":...,"data":{...}}); the one-letter keys are unique across
+ * both levels, so matching on the key alone is enough.
+ */
+static void message_feed(char c) {
+  if (!(json.feed(c) & JSON_VALUE)) return;
+
+  if (json.key_is(KEY_S)) {
+    strlcpy(message_symbol, json.value(), sizeof(message_symbol));
+  } else if (json.key_is(KEY_C)) {
+    message_close = price_parse(json.value());
+  } else if (json.key_is(KEY_O)) {
+    message_open = price_parse(json.value());
+  }
+}
+
+/// A complete text message was scanned: publish its values.
+static void message_commit() {
+  int index = find_symbol_index(message_symbol);
+  if (index < 0) return;
+
+  if (message_close > 0 && out_prices[index] != message_close) {
+    out_prices[index] = message_close;
+    changed++;
+  }
+  if (out_opens != nullptr && message_open > 0) {
+    out_opens[index] = message_open;
+  }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Connection
+// ─────────────────────────────────────────────────────────────────────────────
+
+static void drop_connection() {
+  client.stop();
+  connected    = false;
+  upgraded     = false;
+  next_attempt = millis() + backoff_ms;
+  backoff_ms   = min(backoff_ms * 2, (unsigned long)STREAM_BACKOFF_MAX_MS);
+}
+
+/// Send a PONG echoing @p payload.  Client frames must be masked; a zero mask
+/// key leaves the payload bytes unchanged.
+static void send_pong(const uint8_t* payload, uint8_t len) {
+  uint8_t frame[6 + sizeof(control)];
+  frame[0] = 0x80 | WS_OP_PONG;
+  frame[1] = 0x80 | len;
+  frame[2] = frame[3] = frame[4] = frame[5] = 0;
+  memcpy(frame + 6, payload, len);
+  client.write(frame, 6 + len);
+}
+
+/// Open the TLS socket and send the WebSocket upgrade request.
+static bool open_stream() {
+  if (!configured) {
+    client.setInsecure();
+    client.setBufferSizes(TLS_READ_BUFFER, TLS_WRITE_BUFFER);
+    client.setTimeout(STREAM_TIMEOUT_MS);
+    configured = true;
+  }
+
+  if (!client.connect(STREAM_HOST, STREAM_PORT)) {
+    Serial.println(F("[stream] connect failed"));
+    return false;
+  }
+
+  char request[STREAM_REQUEST_BUFFER];
+  int  len = strlcpy_P(request, STREAM_REQUEST_LINE.text, sizeof(request));
+  // The key only has to be a base64 16-byte nonce; the accept hash is not
+  // checked because the socket is already authenticated by TLS.
+  len += snprintf_P(request + len, sizeof(request) - len,
+                    PSTR(" HTTP/1.1\r\n"
+                         "Host: %s:%d\r\n"
+                         "Upgrade: websocket\r\n"
+                         "Connection: Upgrade\r\n"
+                         "Sec-WebSocket-Key: ZXNwODI2Ni10cmFja2VyIQ==\r\n"
+                         "Sec-WebSocket-Version: 13\r\n"
+                         "\r\n"),
+                    STREAM_HOST, STREAM_PORT);
+  DEBUG_PRINT(request);
+  client.write((const uint8_t*)request, len);
+
+  upgrade_len    = 0;
+  upgrade_status = false;
+  upgrade_start  = millis();
+  return true;
+}
+
+/**
+ * @brief Consume the upgrade response as far as it has arrived.
+ *
+ * Read a byte at a time, so nothing past the blank line ending the headers
+ * is taken: the first frame may follow in the same TLS record.
+ *
+ * @return 1 once "HTTP/1.1 101 ..." and its headers are in, 0 while more is
+ *         due, -1 if the server answered anything but 101.
+ */
+static int read_upgrade() {
+  int c;
+  while ((c = client.read()) >= 0) {
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (upgrade_len < sizeof(upgrade_line) - 1) upgrade_line[upgrade_len++] = (char)c;
+      continue;
+    }
+    upgrade_line[upgrade_len] = '\0';
+    bool blank  = upgrade_len == 0;
+    upgrade_len = 0;
+    if (!upgrade_status) {
+      if (strstr_P(upgrade_line, PSTR(" 101")) == nullptr) {
+        Serial.print(F("[stream] upgrade refused: "));
+        Serial.println(upgrade_line);
+        return -1;
+      }
+      upgrade_status = true;
+    } else if (blank) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Frame decoder
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// All header bytes are in: decode length and opcode.
+static void begin_payload() {
+  frame_fin    = header[0] & 0x80;
+  frame_opcode = header[0] & 0x0F;
+
+  uint8_t  len7 = header[1] & 0x7F;
+  uint64_t len  = len7;
+  if (len7 == 126) {
+    len = ((uint16_t)header[2] << 8) | header[3];
+  } else if (len7 == 127) {
+    len = 0;
+    for (int i = 2; i < 10; i++) len = (len << 8) | header[i];
+  }
+  payload_left = (len > 0xFFFFFFFFull) ? 0xFFFFFFFFul : (uint32_t)len;
+
+  if (frame_opcode == WS_OP_TEXT) {
+    message_opcode = WS_OP_TEXT;
+    message_reset();
+  } else if (frame_opcode != WS_OP_CONTINUATION && frame_opcode < WS_OP_CLOSE) {
+    message_opcode = frame_opcode;       // binary data: skipped
+  }
+  control_len = 0;
+  in_payload  = true;
+}
+
+/// The last payload byte of a frame was consumed.
+static void end_payload() {
+  in_payload  = false;
+  header_len  = 0;
+  header_need = 2;
+
+  switch (frame_opcode) {
+    case WS_OP_PING:
+      send_pong(control, control_len);
+      break;
+    case WS_OP_CLOSE:
+      Serial.println(F("[stream] closed by server"));
+      drop_connection();
+      break;
+    case WS_OP_TEXT:
+    case WS_OP_CONTINUATION:
+      if (frame_fin && message_opcode == WS_OP_TEXT) message_commit();
+      break;
+    default:
+      break;
+  }
+}
+
+static void feed_byte(uint8_t b) {
+  if (!in_payload) {
+    header[header_len++] = b;
+    if (header_len == 2) {
+      uint8_t len7 = header[1] & 0x7F;
+      header_need = 2 + (len7 == 126 ? 2 : len7 == 127 ? 8 : 0)
+                      + ((header[1] & 0x80) ? 4 : 0);
+    }
+    if (header_len == header_need) {
+      begin_payload();
+      if (payload_left == 0) end_payload();
+    }
+    return;
+  }
+
+  if (frame_opcode >= WS_OP_CLOSE) {
+    if (control_len < sizeof(control)) control[control_len++] = b;
+  } else if (message_opcode == WS_OP_TEXT) {
+    message_feed((char)b);
+  }
+
+  if (--payload_left == 0) end_payload();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Public API
+// ─────────────────────────────────────────────────────────────────────────────
+
+int price_stream_poll(price_t* prices, price_t* opens) {
+  unsigned long now = millis();
+
+  if (!connected) {
+    if ((long)(now - next_attempt) < 0) return -1;
+    if (!open_stream()) {
+      drop_connection();
+      return -1;
+    }
+    connected = true;
+    last_data = now;
+  }
+
+  if (!client.connected() || now - last_data > STREAM_SILENCE_MS) {
+    Serial.println(F("[stream] connection lost, reconnecting"));
+    drop_connection();
+    return -1;
+  }
+
+  if (!upgraded) {
+    int result = read_upgrade();
+    if (result == 0) {
+      if (millis() - upgrade_start < STREAM_TIMEOUT_MS) return -1;
+      Serial.println(F("[stream] upgrade timed out"));
+    }
+    if (result <= 0) {
+      drop_connection();
+      return -1;
+    }
+    upgraded    = true;
+    backoff_ms  = STREAM_BACKOFF_MIN_MS;
+    header_len  = 0;
+    header_need = 2;
+    in_payload  = false;
+    message_reset();
+    Serial.println(F("[stream] connected"));
+  }
+
+  out_prices = prices;
+  out_opens  = opens;
+  changed    = 0;
+
+  uint8_t buf[64];
+  int budget = STREAM_MAX_BYTES_PER_POLL;
+  while (connected && budget > 0) {
+    int avail = client.available();
+    if (avail <= 0) break;
+
+    int n = client.read(buf, min(min(avail, (int)sizeof(buf)), budget));
+    if (n <= 0) break;
+    last_data = now;
+    budget   -= n;
+    for (int i = 0; i < n && connected; i++) feed_byte(buf[i]);
+  }
+
+  // Prices from frames ahead of a CLOSE are reported all the same; the
+  // close itself shows up as -1 from the next poll
+  return (connected || changed > 0) ? changed : -1;
+}
+
+void price_stream_close() {
+  client.stop();
+  connected    = false;
+  upgraded     = false;
+  next_attempt = 0;
+  backoff_ms   = STREAM_BACKOFF_MIN_MS;
+}
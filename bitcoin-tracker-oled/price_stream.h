@@ -0,0 +1,50 @@
+/**
+ * @file price_stream.h
+ * @brief Binance WebSocket market stream (miniTicker) as an alternative to REST polling.
+ *
+ * Enabled with @c USE_WEBSOCKET_STREAM in config.h.  One TLS WebSocket to
+ * the combined stream
+ * @code
+ * wss://stream.binance.com:9443/stream?streams=btcusdt@miniTicker/ethusdt@miniTicker
+ * @endcode
+ * pushes a frame per symbol roughly once a second, so prices on screen are as
+ * fresh as the exchange publishes them and no REST request weight is used.
+ *
+ * Example frame (≈230 bytes):
+ * @code
+ * {"stream":"btcusdt@miniTicker","data":{"e":"24hrMiniTicker","E":1672515782136,
+ *  "s":"BTCUSDT","c":"60950.01","o":"59800.00","h":"61200.00","l":"59500.00",
+ *  "v":"1234.5","q":"75000000.0"}}
+ * @endcode
+ *
+ * Frames are decoded and scanned byte by byte into small fixed buffers; no
+ * heap allocation happens per frame.  The socket is reopened automatically
+ * (with back-off) when it drops or goes silent.
+ */
+#pragma once
+
+#include "price.h"
+
+/**
+ * @brief Process whatever stream data has arrived; connect first if needed.
+ *
+ * Returns immediately when no data is pending.  Only (re)connecting blocks,
+ * for the duration of the TLS handshake; the WebSocket upgrade response is
+ * read over the following polls as it arrives.
+ *
+ * miniTicker's @c "o" is the open of the rolling 24 h window, not the
+ * midnight-UTC open, so it is only written to @p opens when the caller opts
+ * in (see @c STREAM_ROLLING_24H_OPEN in config.h).
+ *
+ * @param prices  Array indexed like @c list_of_symbols[]; receives @c "c".
+ * @param opens   Array indexed like @c list_of_symbols[] receiving @c "o",
+ *                or nullptr to leave the daily reference alone.
+ * @return Number of @p prices slots that changed value, or -1 while the
+ *         stream is not connected.  When the server closes the stream, the
+ *         changes from frames ahead of the CLOSE are still returned, and
+ *         the next poll returns -1.
+ */
+int price_stream_poll(price_t* prices, price_t* opens);
+
+/// Close the stream; the next price_stream_poll() reconnects.
+void price_stream_close();
@@ -0,0 +1,31 @@
+/**
+ * @file scheduler.cpp
+ * @brief Cooperative task scheduler implementation.
+ */
+
+#include "scheduler.h"
+
+void task_start(Task& task, unsigned long delay_ms) {
+  task.next_run = millis() + delay_ms;
+  task.enabled  = true;
+}
+
+void task_stop(Task& task) {
+  task.enabled = false;
+}
+
+void scheduler_run(Task* tasks, int count) {
+  for (int i = 0; i < count; i++) {
+    Task& task = tasks[i];
+    unsigned long now = millis();
+
+    // Signed difference keeps the comparison correct across millis() wrap-around
+    if (!task.enabled || (long)(now - task.next_run) < 0) continue;
+
+    task.next_run += task.period_ms;
+    // If we fell more than a whole period behind, resync instead of bursting
+    if ((long)(now - task.next_run) >= 0) task.next_run = now + task.period_ms;
+
+    task.fn();
+  }
+}
@@ -0,0 +1,32 @@
+/**
+ * @file scheduler.h
+ * @brief Minimal cooperative task scheduler driven by millis() deadlines.
+ *
+ * Each task is a plain function plus a period.  scheduler_run() is called
+ * from loop() and runs every task whose deadline has passed; tasks must
+ * return quickly (no delay(), no blocking network waits) so the others keep
+ * their timing.  Deadlines advance by whole periods rather than from "now",
+ * so a late run does not shift the rest of the schedule.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+typedef void (*TaskFn)();
+
+/// One periodic task.  Initialise with {fn, period_ms} and call task_start().
+struct Task {
+  TaskFn        fn;
+  unsigned long period_ms;
+  unsigned long next_run = 0;       ///< millis() deadline of the next run
+  bool          enabled  = false;
+};
+
+/// Enable @p task and make it due @p delay_ms from now.
+void task_start(Task& task, unsigned long delay_ms = 0);
+
+/// Disable @p task until the next task_start().
+void task_stop(Task& task);
+
+/// Run every enabled task in @p tasks whose deadline has passed, in order.
+void scheduler_run(Task* tasks, int count);
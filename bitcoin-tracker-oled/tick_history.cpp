@@ -0,0 +1,118 @@
+/**
+ * @file tick_history.cpp
+ * @brief Delta-encoded tick ring implementation.
+ */
+
+#include "tick_history.h"
+
+// A zigzag-encoded int32 takes at most 5 varint bytes.
+#define VARINT_MAX_BYTES 5
+
+/// Quantum giving @p price 7 significant digits (at least 1 unit).
+static price_t quantum_for(price_t price) {
+  price_t quantum = 1;
+  while (price / quantum >= 10000000LL) quantum *= 10;
+  return quantum;
+}
+
+/// Zigzag then LEB128: small deltas of either sign take one or two bytes.
+static uint8_t write_delta(uint8_t* out, int32_t delta) {
+  uint32_t v = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+  uint8_t  n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+int32_t tick_history_read_delta(const uint8_t*& p) {
+  uint32_t v     = 0;
+  uint8_t  shift = 0;
+  uint8_t  byte;
+  do {
+    byte   = *p++;
+    v     |= (uint32_t)(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+TickHistory::Block& TickHistory::open_block(int32_t value) {
+  if (blocks_used_ == TICK_HISTORY_BLOCKS) {
+    size_ -= blocks_[first_].count;
+    first_ = (first_ + 1) % TICK_HISTORY_BLOCKS;
+    blocks_used_--;
+  }
+  Block& b = blocks_[(first_ + blocks_used_) % TICK_HISTORY_BLOCKS];
+  blocks_used_++;
+
+  b.base  = value;
+  b.min   = value;
+  b.max   = value;
+  b.count = 1;
+  b.used  = 0;
+  return b;
+}
+
+void TickHistory::push(price_t price) {
+  if (price <= 0) return;
+  if (quantum_ == 0) quantum_ = quantum_for(price);
+
+  price_t scaled = (price + quantum_ / 2) / quantum_;
+  if (scaled > INT32_MAX) {
+    // The price grew ~200× since the first sample: start over at a coarser scale
+    clear();
+    quantum_ = quantum_for(price);
+    scaled   = (price + quantum_ / 2) / quantum_;
+  }
+  int32_t value = (int32_t)scaled;
+
+  uint8_t delta[VARINT_MAX_BYTES];
+  uint8_t n = 0;
+  Block*  b = nullptr;
+  if (blocks_used_ > 0) {
+    b = &blocks_[(first_ + blocks_used_ - 1) % TICK_HISTORY_BLOCKS];
+    n = write_delta(delta, value - last_);
+  }
+
+  if (b == nullptr || b->count == 255 || b->used + n > TICK_HISTORY_BLOCK_BYTES) {
+    open_block(value);
+  } else {
+    memcpy(b->data + b->used, delta, n);
+    b->used += n;
+    b->count++;
+    if (value < b->min) b->min = value;
+    if (value > b->max) b->max = value;
+  }
+  last_ = value;
+  size_++;
+}
+
+void TickHistory::clear() {
+  first_       = 0;
+  blocks_used_ = 0;
+  size_        = 0;
+  quantum_     = 0;
+}
+
+bool TickHistory::is_newest(price_t price) const {
+  return size_ > 0 && price > 0 && (price + quantum_ / 2) / quantum_ == last_;
+}
+
+price_t TickHistory::lowest() const {
+  int32_t lo = INT32_MAX;
+  for (uint8_t i = 0; i < blocks_used_; i++) {
+    if (block(i).min < lo) lo = block(i).min;
+  }
+  return to_price(lo);
+}
+
+price_t TickHistory::highest() const {
+  int32_t hi = 0;
+  for (uint8_t i = 0; i < blocks_used_; i++) {
+    if (block(i).max > hi) hi = block(i).max;
+  }
+  return to_price(hi);
+}
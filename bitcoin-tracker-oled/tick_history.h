@@ -0,0 +1,88 @@
+/**
+ * @file tick_history.h
+ * @brief Recent prices of one symbol in a compact, fixed-size ring.
+ *
+ * Samples are stored as varint-encoded differences, in blocks:
+ * @verbatim
+ *  block: base (first sample) | min | max | count | zigzag varint deltas ...
+ * @endverbatim
+ * A tick of a few dollars on BTC costs 2 bytes instead of the 8 of a price_t,
+ * so a few hundred samples per symbol fit in well under 1 KB.  When the ring
+ * is full the oldest whole block is dropped, which needs no re-encoding: the
+ * next block starts from its own absolute base.
+ *
+ * Each block keeps the min and max of its samples, updated on every push, so
+ * push() is O(1) and lowest()/highest() scan only the TICK_HISTORY_BLOCKS block
+ * summaries, never the samples.
+ *
+ * Samples are kept to 7 significant digits of the first price seen (for the
+ * major pairs that is exactly the exchange's tick size, e.g. $0.01 on BTC),
+ * which keeps every value in an int32 and the deltas small.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "config.h"
+#include "price.h"
+
+class TickHistory {
+ public:
+  /// Append @p price (ignored unless positive); may drop the oldest block.
+  void push(price_t price);
+
+  /// Forget every sample.
+  void clear();
+
+  /// Number of samples held.
+  uint16_t size() const { return size_; }
+
+  /// True if @p price, at the precision samples are kept in, is the newest sample.
+  bool is_newest(price_t price) const;
+
+  /// Lowest / highest sample held; only meaningful when size() > 0.
+  price_t lowest() const;
+  price_t highest() const;
+
+  /// Call @p fn(price_t) for every sample, oldest first.
+  template <class Fn>
+  void for_each(Fn fn) const;
+
+ private:
+  struct Block {
+    int32_t base;                            ///< first sample, in quanta
+    int32_t min;
+    int32_t max;
+    uint8_t count;                           ///< samples, including base
+    uint8_t used;                            ///< bytes of data[] in use
+    uint8_t data[TICK_HISTORY_BLOCK_BYTES];
+  };
+
+  Block& open_block(int32_t value);
+  const Block& block(uint8_t i) const { return blocks_[(first_ + i) % TICK_HISTORY_BLOCKS]; }
+  price_t to_price(int32_t value) const { return (price_t)value * quantum_; }
+
+  Block    blocks_[TICK_HISTORY_BLOCKS];
+  uint8_t  first_       = 0;                 ///< oldest block in use
+  uint8_t  blocks_used_ = 0;
+  uint16_t size_        = 0;
+  int32_t  last_        = 0;                 ///< newest sample, in quanta
+  price_t  quantum_     = 0;                 ///< price_t units per stored unit; 0 = unset
+};
+
+/// Decode one zigzag varint from @p p, advancing it.
+int32_t tick_history_read_delta(const uint8_t*& p);
+
+template <class Fn>
+void TickHistory::for_each(Fn fn) const {
+  for (uint8_t i = 0; i < blocks_used_; i++) {
+    const Block&   b     = block(i);
+    const uint8_t* p     = b.data;
+    int32_t        value = b.base;
+    fn(to_price(value));
+    for (uint8_t n = 1; n < b.count; n++) {
+      value += tick_history_read_delta(p);
+      fn(to_price(value));
+    }
+  }
+}
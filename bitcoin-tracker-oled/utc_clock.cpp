@@ -0,0 +1,75 @@
+/**
+ * @file utc_clock.cpp
+ * @brief HTTP date parsing for the UTC clock.
+ */
+
+#include "utc_clock.h"
+
+static const char MONTHS[] PROGMEM = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+/// Parse exactly @p width decimal digits at @p *p and advance past them.
+static bool parse_digits(const char** p, uint8_t width, uint16_t* out) {
+  uint16_t value = 0;
+  for (uint8_t i = 0; i < width; i++) {
+    char c = (*p)[i];
+    if (c < '0' || c > '9') return false;
+    value = value * 10 + (c - '0');
+  }
+  *p  += width;
+  *out = value;
+  return true;
+}
+
+/// Expect the character @p c at @p *p and advance past it.
+static bool parse_char(const char** p, char c) {
+  if (**p != c) return false;
+  (*p)++;
+  return true;
+}
+
+/**
+ * @brief Days from 1970-01-01 to the given civil date (proleptic Gregorian).
+ *
+ * Howard Hinnant's days_from_civil(), restricted to years ≥ 1970.
+ */
+static uint32_t days_from_civil(uint16_t y, uint16_t m, uint16_t d) {
+  if (m <= 2) y--;
+  uint32_t era = y / 400;
+  uint32_t yoe = y - era * 400;                                // [0, 399]
+  uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;       // [0, 146096]
+  return era * 146097 + doe - 719468;
+}
+
+bool http_date_parse(const char* text, uint32_t* epoch) {
+  if (text == nullptr) return false;
+
+  const char* p = text;
+  while (*p == ' ') p++;
+
+  // "Fri, " — the weekday is redundant, only its shape is checked
+  if (strlen(p) < 29 || p[3] != ',' || p[4] != ' ') return false;
+  p += 5;
+
+  uint16_t day, month = 0, year, hh, mm, ss;
+  if (!parse_digits(&p, 2, &day) || !parse_char(&p, ' ')) return false;
+  for (uint8_t i = 0; i < 12; i++) {
+    if (strncmp_P(p, MONTHS + i * 3, 3) == 0) {
+      month = i + 1;
+      break;
+    }
+  }
+  if (month == 0) return false;
+  p += 3;
+  if (!parse_char(&p, ' ') || !parse_digits(&p, 4, &year) || !parse_char(&p, ' ')
+      || !parse_digits(&p, 2, &hh) || !parse_char(&p, ':')
+      || !parse_digits(&p, 2, &mm) || !parse_char(&p, ':')
+      || !parse_digits(&p, 2, &ss)) {
+    return false;
+  }
+  if (year < 1970 || day < 1 || day > 31 || hh > 23 || mm > 59 || ss > 60) return false;
+
+  *epoch = days_from_civil(year, month, day) * UTC_SECONDS_PER_DAY
+         + hh * 3600UL + mm * 60UL + ss;
+  return true;
+}
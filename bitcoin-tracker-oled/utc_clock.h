@@ -0,0 +1,84 @@
+/**
+ * @file utc_clock.h
+ * @brief UTC wall clock kept from the HTTP @c Date header of API responses.
+ *
+ * Every Binance response carries the server time, e.g.
+ * @code
+ * Date: Fri, 16 Oct 2026 23:59:58 GMT
+ * @endcode
+ * so the tracker never needs NTP: each response re-anchors the clock and
+ * millis() interpolates in between.  The only thing built on top of it is
+ * detecting when the UTC day changes, which is when Binance's daily open
+ * (the reference for the % change) moves.
+ *
+ * The clock never reads millis() itself — every call takes the current
+ * millisecond count — so the rollover logic runs unchanged on a host with a
+ * simulated clock.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#define UTC_SECONDS_PER_DAY 86400UL
+
+/**
+ * @brief Parse an RFC 7231 IMF-fixdate ("Fri, 16 Oct 2026 23:59:58 GMT").
+ * @param text   Header value, leading spaces allowed.
+ * @param epoch  Receives seconds since 1970-01-01 00:00:00 UTC.
+ * @return false if @p text is not in that format.
+ */
+bool http_date_parse(const char* text, uint32_t* epoch);
+
+class UtcClock {
+ public:
+  /// Anchor the clock: it was @p epoch (UTC seconds) at millis() == @p now_ms.
+  void sync(uint32_t epoch, unsigned long now_ms) {
+    epoch_   = epoch;
+    sync_ms_ = now_ms;
+  }
+
+  /// True once sync() has been called.
+  bool valid() const { return epoch_ != 0; }
+
+  /// UTC seconds at millis() == @p now_ms.
+  uint32_t now(unsigned long now_ms) const {
+    return epoch_ + (now_ms - sync_ms_) / 1000;
+  }
+
+  /// Days since 1970-01-01 (the UTC trading day) at millis() == @p now_ms.
+  uint32_t day(unsigned long now_ms) const {
+    return now(now_ms) / UTC_SECONDS_PER_DAY;
+  }
+
+ private:
+  uint32_t      epoch_   = 0;
+  unsigned long sync_ms_ = 0;
+};
+
+/**
+ * @brief Tracks which UTC day the daily opens belong to.
+ *
+ * @code
+ * if (rollover.due(clock, millis())) refresh_opens();
+ * // ... once the refreshed opens have been stored:
+ * rollover.mark(clock, millis());
+ * @endcode
+ */
+class DayRollover {
+ public:
+  /// The opens just fetched are for the current UTC day.
+  void mark(const UtcClock& clock, unsigned long now_ms) {
+    day_ = clock.valid() ? clock.day(now_ms) : 0;
+  }
+
+  /// The opens are for UTC day @p day (days since 1970), e.g. restored from flash.
+  void mark_day(uint32_t day) { day_ = day; }
+
+  /// True when the opens were marked on an earlier UTC day than now.
+  bool due(const UtcClock& clock, unsigned long now_ms) const {
+    return clock.valid() && day_ != 0 && clock.day(now_ms) != day_;
+  }
+
+ private:
+  uint32_t day_ = 0;   ///< 0: opens not marked yet
+};
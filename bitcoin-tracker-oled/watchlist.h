@@ -0,0 +1,174 @@
+/**
+ * @file watchlist.h
+ * @brief Compile-time view of @c list_of_symbols: checks, labels and request text.
+ *
+ * The watchlist never changes at run time, so everything derived from it is
+ * worked out by the compiler:
+ *  - every symbol is checked to be a plain upper-case Binance base asset
+ *    (letters and digits, so it needs no URL escaping) that fits the OLED
+ *    symbol box, and to appear only once — a bad list fails the build with
+ *    a message instead of drawing over the icon or asking for a pair that
+ *    does not exist;
+ *  - the fit check uses symbol_label_size(), the same rule the renderer
+ *    applies when it draws the label, so the two cannot disagree;
+ *  - every symbol is at most @c SYMBOL_MAX_LENGTH characters, so text
+ *    buffers that hold a symbol are sized from that;
+ *  - request targets listing the whole watchlist, e.g.
+ *    @c /api/v3/ticker/price?symbols=%5B%22BTCUSDT%22,%22ETHUSDT%22%5D, are
+ *    rendered into flash by WATCHLIST_TEXT(), and their exact length is
+ *    known, so the stack buffers they are copied into are sized, and checked
+ *    against @c REQUEST_STACK_BYTES, before the sketch ever runs.
+ *
+ * Example:
+ * @code
+ * static constexpr WatchlistJoin JOIN_PAIRS = {"pairs=", "", "USDT", ",", ""};
+ * WATCHLIST_TEXT(PATH_PAIRS, JOIN_PAIRS);   // "pairs=BTCUSDT,ETHUSDT" in PROGMEM
+ * char path[sizeof(PATH_PAIRS)];
+ * strcpy_P(path, PATH_PAIRS.text);
+ * @endcode
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "config.h"
+
+/// Inside width of the rounded symbol box on the OLED price screen, in pixels.
+#define SYMBOL_BOX_WIDTH  44
+#define SYMBOL_BOX_HEIGHT 24
+
+/// Longest symbol whose label fits the box (at text size 1).
+#define SYMBOL_MAX_LENGTH 7
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Symbols
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// strlen() that the compiler can evaluate.
+constexpr size_t symbol_length(const char* symbol) {
+  size_t n = 0;
+  while (symbol[n] != '\0') n++;
+  return n;
+}
+
+/// Width in pixels of @p length characters at GFX text size @p size.
+constexpr int16_t label_width(size_t length, uint8_t size) {
+  return (int16_t)(6 * size * length) - size;
+}
+
+/// Largest text size (2 or 1) at which @p symbol fits the box; 0 if it does not fit.
+constexpr uint8_t symbol_label_size(const char* symbol) {
+  return (label_width(symbol_length(symbol), 2) <= SYMBOL_BOX_WIDTH - 4) ? 2
+       : (label_width(symbol_length(symbol), 1) <= SYMBOL_BOX_WIDTH - 2) ? 1
+       : 0;
+}
+
+static_assert(symbol_label_size("ABCDEFG") == 1 && symbol_label_size("ABCDEFGH") == 0,
+              "SYMBOL_MAX_LENGTH no longer matches the symbol box");
+
+/// True if @p symbol is upper-case letters and digits, and its label fits the box.
+constexpr bool symbol_is_valid(const char* symbol) {
+  for (const char* p = symbol; *p; p++) {
+    if (!((*p >= 'A' && *p <= 'Z') || (*p >= '0' && *p <= '9'))) return false;
+  }
+  return symbol[0] != '\0' && symbol_label_size(symbol) > 0;
+}
+
+constexpr bool symbols_equal(const char* a, const char* b) {
+  size_t i = 0;
+  while (a[i] != '\0' && a[i] == b[i]) i++;
+  return a[i] == b[i];
+}
+
+/// Index of the first entry of list_of_symbols[] that is invalid or repeated; -1 if none.
+constexpr int watchlist_first_bad() {
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    if (!symbol_is_valid(list_of_symbols[i])) return i;
+    for (int j = 0; j < i; j++) {
+      if (symbols_equal(list_of_symbols[i], list_of_symbols[j])) return i;
+    }
+  }
+  return -1;
+}
+
+static_assert(size_of_list_of_symbols >= 1, "list_of_symbols must not be empty");
+static_assert(watchlist_first_bad() < 0,
+              "list_of_symbols: each symbol must be 1-7 upper-case letters or digits "
+              "(a Binance base asset such as \"BTC\"), listed once");
+
+/// FNV-1a hash of the watchlist, seeded with @p seed; changes when any symbol does.
+constexpr uint32_t watchlist_hash(uint32_t seed) {
+  uint32_t hash = 2166136261u ^ seed;
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    for (const char* p = list_of_symbols[i]; *p; p++) {
+      hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+    hash = (hash ^ ',') * 16777619u;
+  }
+  return hash;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Request text
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// How the symbols are joined into one piece of text.
+struct WatchlistJoin {
+  const char* prefix;          ///< once, before the first symbol
+  const char* before;          ///< before each symbol
+  const char* after;           ///< after each symbol
+  const char* separator;       ///< between two symbols
+  const char* suffix;          ///< once, after the last symbol
+  bool        lowercase;       ///< symbols in lower case (stream names)
+};
+
+/// Copy @p text to @p out + @p n (if @p out is set); return the new length.
+constexpr size_t join_append(char* out, size_t n, const char* text) {
+  for (; *text; text++, n++) {
+    if (out) out[n] = *text;
+  }
+  return n;
+}
+
+/**
+ * @brief Join list_of_symbols[] as @p join describes.
+ *
+ * @param out  Receives the text and its terminator; nullptr to only measure.
+ * @return Length of the text, without the terminator.
+ */
+constexpr size_t watchlist_join(const WatchlistJoin& join, char* out) {
+  size_t n = join_append(out, 0, join.prefix);
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    if (i > 0) n = join_append(out, n, join.separator);
+    n = join_append(out, n, join.before);
+    for (const char* p = list_of_symbols[i]; *p; p++, n++) {
+      if (out) out[n] = (join.lowercase && *p >= 'A' && *p <= 'Z') ? *p - 'A' + 'a' : *p;
+    }
+    n = join_append(out, n, join.after);
+  }
+  n = join_append(out, n, join.suffix);
+  if (out) out[n] = '\0';
+  return n;
+}
+
+/// Text of a known length, built by the compiler; read it with the *_P functions.
+template <size_t N>
+struct FlashText {
+  char text[N];
+};
+
+template <size_t N>
+constexpr FlashText<N> watchlist_render(const WatchlistJoin& join) {
+  FlashText<N> rendered{};
+  watchlist_join(join, rendered.text);
+  return rendered;
+}
+
+/**
+ * @brief Define @p name as the watchlist joined by @p join, in PROGMEM.
+ *
+ * @c sizeof(name) is the length of the text plus its terminator.
+ */
+#define WATCHLIST_TEXT(name, join)                                                   \
+  static constexpr FlashText<watchlist_join(join, nullptr) + 1> name PROGMEM =       \
+      watchlist_render<watchlist_join(join, nullptr) + 1>(join)
@@ -0,0 +1,274 @@
+/**
+ * @file bench_json.cpp
+ * @brief Batched-response parsing: JsonScanner against the ArduinoJson path it replaced.
+ *
+ * Parses ticker/price and ticker/tradingDay bodies for watchlists of 2, 10
+ * and 50 symbols --rounds times each, two ways:
+ *  - scanner: the loop of parse_batch() in api.cpp, one byte at a time
+ *    through JsonScanner, prices kept as price_t;
+ *  - arduinojson: the retired parse_batch(), one filtered
+ *    StaticJsonDocument<128> per array element, prices as double.
+ *
+ * For each it reports time and TSC cycles per response (cycles on x86-64
+ * only), the deepest stack the parse reached (mock::stack_peak(), host
+ * frames) and heap allocations per response.  Fails if the two disagree on
+ * any price or if the scanner path allocates.
+ *
+ * ArduinoJson is not part of the tree.  The second column is built when
+ * CMake finds ArduinoJson 6 (-DARDUINOJSON_ROOT=<checkout>); otherwise it
+ * is reported as not built.
+ *
+ *   bench_json [--rounds N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+
+#if defined(__x86_64__)
+  #include <x86intrin.h>
+#endif
+
+#include "api.h"
+#include "check.h"
+#include "json_scanner.h"
+#include "mock_host.h"
+#include "price.h"
+
+#if HAVE_ARDUINOJSON
+  #define ARDUINOJSON_USE_DOUBLE 1
+  #include <ArduinoJson.h>
+#endif
+
+static const char KEY_SYMBOL[]     PROGMEM = "symbol";
+static const char KEY_PRICE[]      PROGMEM = "price";
+static const char KEY_OPEN_PRICE[] PROGMEM = "openPrice";
+
+#define MAX_SYMBOLS 50
+
+/// One response body and what the parse made of it.
+struct Body {
+  const char* label;
+  PGM_P       field;
+  std::string text;
+};
+
+struct Cost {
+  double ns;
+  double cycles;
+  size_t stack;
+  double allocations;
+};
+
+static volatile int sink;
+
+static uint64_t cycles_now() {
+#if defined(__x86_64__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/// A batched body for @p symbols pairs, the first ones from the watchlist.
+static std::string batch_body(int symbols, bool trading_day) {
+  std::string body = "[";
+  for (int i = 0; i < symbols; i++) {
+    char pair[16];
+    if (i < size_of_list_of_symbols) snprintf(pair, sizeof(pair), "%sUSDT", list_of_symbols[i]);
+    else                             snprintf(pair, sizeof(pair), "X%02dUSDT", i);
+    char element[512];
+    if (trading_day) {
+      snprintf(element, sizeof(element),
+               "%s{\"symbol\":\"%s\",\"priceChange\":\"950.01000000\","
+               "\"priceChangePercent\":\"1.583\",\"weightedAvgPrice\":\"60411.20000000\","
+               "\"openPrice\":\"%d.%08d\",\"highPrice\":\"61012.00000000\","
+               "\"lowPrice\":\"59880.50000000\",\"lastPrice\":\"60950.01000000\","
+               "\"volume\":\"10250.12000000\",\"quoteVolume\":\"619230000.00000000\","
+               "\"openTime\":1760572800000,\"closeTime\":1760659199999,"
+               "\"firstId\":1,\"lastId\":2,\"count\":2}",
+               i ? "," : "", pair, 60000 + i, i * 1234567);
+    } else {
+      snprintf(element, sizeof(element), "%s{\"symbol\":\"%s\",\"price\":\"%d.%08d\"}",
+               i ? "," : "", pair, 60950 + i, i * 7654321);
+    }
+    body += element;
+  }
+  return body + "]";
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scanner path
+// ─────────────────────────────────────────────────────────────────────────────
+
+static int parse_scanner(const Body& body, price_t* prices) {
+  JsonScanner json;
+  int         index   = -1;
+  int         updated = 0;
+  price_t     value   = -1;
+  for (char c : body.text) {
+    if (json.done()) break;
+    uint8_t events = json.feed(c);
+    if ((events & JSON_VALUE) && json.depth() == 2) {
+      if      (json.key_is(KEY_SYMBOL)) index = find_symbol_index(json.value());
+      else if (json.key_is(body.field)) value = price_parse(json.value());
+    }
+    if ((events & JSON_END) && json.depth() == 1) {
+      if (index >= 0 && value > 0) {
+        prices[index] = value;
+        updated++;
+      }
+      index = -1;
+      value = -1;
+    }
+  }
+  return json.done() ? updated : -1;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ArduinoJson path
+// ─────────────────────────────────────────────────────────────────────────────
+
+#if HAVE_ARDUINOJSON
+
+/// The response body as the Stream the old code read from: read() and readBytes().
+class BodyReader {
+ public:
+  explicit BodyReader(const std::string& text) : p_(text.data()), end_(p_ + text.size()) {}
+
+  int read() { return (p_ < end_) ? (uint8_t)*p_++ : -1; }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && p_ < end_) buffer[n++] = *p_++;
+    return n;
+  }
+
+  /// Stream::find(c): skip past the next @p c.
+  bool find(char c) {
+    int b;
+    while ((b = read()) >= 0) {
+      if (b == c) return true;
+    }
+    return false;
+  }
+
+  /// Stream::findUntil(target, terminator) for one-character strings.
+  bool find_until(char target, char terminator) {
+    int b;
+    while ((b = read()) >= 0) {
+      if (b == target)     return true;
+      if (b == terminator) return false;
+    }
+    return false;
+  }
+
+ private:
+  const char* p_;
+  const char* end_;
+};
+
+static int parse_arduinojson(const Body& body, double* prices) {
+  StaticJsonDocument<64> filter;
+  filter["symbol"]   = true;
+  filter[body.field] = true;
+
+  BodyReader stream(body.text);
+  if (!stream.find('[')) return -1;
+
+  int updated = 0;
+  do {
+    StaticJsonDocument<128> doc;
+    DeserializationError    err =
+        deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+    if (err) return -1;
+
+    int index = find_symbol_index(doc["symbol"].as<const char*>());
+    if (index >= 0) {
+      prices[index] = doc[body.field].as<double>();
+      updated++;
+    }
+  } while (stream.find_until(',', ']'));
+  return updated;
+}
+
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Measurement
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Run @p parse over @p body @p rounds times; the first run also records the stack peak.
+template <class Parse>
+static Cost measure(int rounds, Parse parse) {
+  Cost cost = {};
+  mock::stack_paint();
+  {
+    mock::DeviceScope device;
+    sink = parse();
+  }
+  cost.stack = mock::stack_peak();
+
+  mock::HeapStats before = mock::heap();
+  auto            start  = std::chrono::steady_clock::now();
+  uint64_t        tsc    = cycles_now();
+  {
+    mock::DeviceScope device;
+    for (int r = 0; r < rounds; r++) sink = parse();
+  }
+  cost.cycles = (double)(cycles_now() - tsc) / rounds;
+  cost.ns     = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+                .count() / rounds;
+  cost.allocations = (double)(mock::heap().allocations - before.allocations) / rounds;
+  return cost;
+}
+
+int main(int argc, char** argv) {
+  int rounds = 2000;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) rounds = atoi(argv[++i]);
+  }
+
+  printf("bench_json: %d rounds per body\n\n", rounds);
+  printf("%-22s %6s | %10s %10s %7s %7s | %10s %10s %7s %7s\n", "", "bytes", "scanner ns",
+         "cycles", "stack", "allocs", "ajson ns", "cycles", "stack", "allocs");
+
+  const int sizes[] = {2, 10, MAX_SYMBOLS};
+  for (int symbols : sizes) {
+    for (int trading_day = 0; trading_day < 2; trading_day++) {
+      Body body = {trading_day ? "tradingDay" : "ticker/price",
+                   trading_day ? KEY_OPEN_PRICE : KEY_PRICE, batch_body(symbols, trading_day)};
+      char name[32];
+      snprintf(name, sizeof(name), "%s x%d", body.label, symbols);
+
+      price_t fixed[MAX_SYMBOLS] = {};
+      int     found              = parse_scanner(body, fixed);
+      Cost    scanner            = measure(rounds, [&] { return parse_scanner(body, fixed); });
+      CHECK_EQ(found, size_of_list_of_symbols < symbols ? size_of_list_of_symbols : symbols);
+      CHECK_EQ(scanner.allocations, 0);
+
+      printf("%-22s %6zu | %10.0f %10.0f %7zu %7.2f | ", name, body.text.size(), scanner.ns,
+             scanner.cycles, scanner.stack, scanner.allocations);
+#if HAVE_ARDUINOJSON
+      double doubles[MAX_SYMBOLS] = {};
+      CHECK_EQ(parse_arduinojson(body, doubles), found);
+      Cost ajson = measure(rounds, [&] { return parse_arduinojson(body, doubles); });
+      for (int i = 0; i < found; i++) CHECK_EQ(llround(doubles[i] * PRICE_SCALE), fixed[i]);
+      printf("%10.0f %10.0f %7zu %7.2f\n", ajson.ns, ajson.cycles, ajson.stack,
+             ajson.allocations);
+#else
+      printf("%10s\n", "not built");
+#endif
+    }
+  }
+  printf("\n");
+#if !HAVE_ARDUINOJSON
+  printf("ArduinoJson 6 not found: configure with -DARDUINOJSON_ROOT=<checkout> "
+         "for the side-by-side figures.\n\n");
+#endif
+  return check_failures();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file bench_lcd_heap.cpp
+ * @brief Heap churn of the LCD build per poll cycle.
+ *
+ * Boots the LCD build (DISPLAY_BACKEND_LCD) against the scripted Binance
+ * API and runs --polls price polls with a moving price, so every cycle
+ * fetches, parses and rewrites the LCD rows.  Reports allocations, frees
+ * and bytes allocated per cycle once warmed up, and fails unless all three
+ * are zero — the retired String/DynamicJsonDocument sketch allocated on
+ * every cycle.
+ *
+ *   bench_lcd_heap [--polls N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "sim.h"
+#include "sketch.h"
+
+int main(int argc, char** argv) {
+  int polls = 500;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--polls") == 0 && i + 1 < argc) polls = atoi(argv[++i]);
+  }
+
+  mock::serial_echo(false);
+  MockBinance binance;
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 30000));
+
+  uint32_t cents     = 6095001;
+  auto     next_poll = [&] {
+    uint32_t seen = binance.ticker_requests;
+    char     text[32];
+    cents += (cents % 3 == 0) ? 107 : 3;
+    snprintf(text, sizeof(text), "%u.%02u000000", cents / 100, cents % 100);
+    binance.set_price("BTCUSDT", text);
+    snprintf(text, sizeof(text), "%u.%02u000000", cents / 2500, cents % 100);
+    binance.set_price("ETHUSDT", text);
+    return sim::run_until([&] { return binance.ticker_requests > seen; }, 30000);
+  };
+  for (int i = 0; i < 5; i++) next_poll();
+  sim::run_ms(500);
+
+  mock::HeapStats before        = mock::heap();
+  uint64_t        writes_before = mock::lcd_writes();
+  mock::heap_reset_peak();
+
+  int done = 0;
+  while (done < polls && next_poll()) done++;
+  sim::run_ms(500);
+
+  mock::HeapStats after = mock::heap();
+  double          n     = done ? done : 1;
+  printf("bench_lcd_heap: %d polls\n\n", done);
+  printf("allocations/cycle  %10.2f\n", (double)(after.allocations - before.allocations) / n);
+  printf("frees/cycle        %10.2f\n", (double)(after.frees - before.frees) / n);
+  printf("bytes/cycle        %10.2f\n", (double)(after.bytes_total - before.bytes_total) / n);
+  printf("heap held (bytes)  %10zu\n", after.bytes);
+  printf("heap peak (bytes)  %10zu of %u\n", after.peak, mock::DEVICE_HEAP_BYTES);
+  printf("LCD chars/cycle    %10.1f\n", (double)(mock::lcd_writes() - writes_before) / n);
+  printf("screen now         [%s]\n                   [%s]\n\n", mock::lcd_row(0).c_str(),
+         mock::lcd_row(1).c_str());
+
+  CHECK_EQ(done, polls);
+  CHECK_EQ(after.allocations - before.allocations, 0);
+  CHECK_EQ(after.frees - before.frees, 0);
+  CHECK_EQ(after.bytes_total - before.bytes_total, 0);
+  CHECK_EQ(after.bytes, before.bytes);
+  CHECK_GE(mock::lcd_writes() - writes_before, 1);
+  return check_failures();
+}
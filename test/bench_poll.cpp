@@ -0,0 +1,107 @@
+/**
+ * @file bench_poll.cpp
+ * @brief Poll-cycle benchmark: phase timings, heap and I2C traffic per poll.
+ *
+ * Boots the OLED build against the scripted Binance API and runs --polls
+ * price polls, moving the BTC price on every one so each poll also redraws
+ * and animates.  The clock runs in real time, so the phase figures are what
+ * the code costs on this machine (the network itself is simulated).
+ *
+ * Fails if a steady-state poll allocates: after the first few polls the
+ * fetch → parse → render cycle must not touch the heap.
+ *
+ *   bench_poll [--polls N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "metrics.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "sim.h"
+#include "sketch.h"
+
+static const char* const PHASES[] = {"dns", "connect", "ttfb", "parse", "render", "frame"};
+
+struct PhaseTotals {
+  double count[PHASE_COUNT];
+  double sum_s[PHASE_COUNT];
+};
+
+static PhaseTotals phase_totals() {
+  PhaseTotals totals;
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    char series[96];
+    snprintf(series, sizeof(series), "tracker_phase_duration_seconds_count{phase=\"%s\"}",
+             PHASES[p]);
+    totals.count[p] = sim::metric(series);
+    snprintf(series, sizeof(series), "tracker_phase_duration_seconds_sum{phase=\"%s\"}",
+             PHASES[p]);
+    totals.sum_s[p] = sim::metric(series);
+  }
+  return totals;
+}
+
+int main(int argc, char** argv) {
+  int polls = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--polls") == 0 && i + 1 < argc) polls = atoi(argv[++i]);
+  }
+
+  mock::serial_echo(false);
+  mock::clock_realtime(true);
+  MockBinance binance;
+
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 30000));
+
+  // Warm-up: connection open, candles fetched, every lazy buffer allocated
+  uint32_t price = 6095001;
+  auto next_poll = [&] {
+    uint32_t seen = binance.ticker_requests;
+    char     text[32];
+    price += (price % 3 == 0) ? 7 : 3;
+    snprintf(text, sizeof(text), "%u.%02u000000", price / 100, price % 100);
+    binance.set_price("BTCUSDT", text);
+    return sim::run_until([&] { return binance.ticker_requests > seen; }, 30000);
+  };
+  for (int i = 0; i < 5; i++) next_poll();
+  sim::run_ms(500);
+
+  PhaseTotals     before      = phase_totals();
+  mock::HeapStats heap_before = mock::heap();
+  uint64_t        wire_before = mock::wire_bytes();
+  uint32_t        conn_before = binance.connections;
+  mock::heap_reset_peak();
+
+  int done = 0;
+  while (done < polls && next_poll()) done++;
+  sim::run_ms(500);                           // let the last response land
+
+  PhaseTotals     after      = phase_totals();
+  mock::HeapStats heap_after = mock::heap();
+
+  printf("bench_poll: %d polls\n\n", done);
+  printf("%-8s %8s %12s\n", "phase", "samples", "mean (us)");
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    double n = after.count[p] - before.count[p];
+    double s = after.sum_s[p] - before.sum_s[p];
+    printf("%-8s %8.0f %12.1f\n", PHASES[p], n, n > 0 ? s * 1e6 / n : 0.0);
+  }
+  printf("\n");
+  printf("allocations/poll   %10.2f\n",
+         (double)(heap_after.allocations - heap_before.allocations) / (done ? done : 1));
+  printf("heap peak (bytes)  %10zu of %u\n", heap_after.peak, mock::DEVICE_HEAP_BYTES);
+  printf("I2C bytes/poll     %10.0f\n",
+         (double)(mock::wire_bytes() - wire_before) / (done ? done : 1));
+  printf("reconnects         %10u\n", binance.connections - conn_before);
+  printf("\n");
+
+  CHECK_EQ(done, polls);
+  CHECK_EQ(heap_after.allocations - heap_before.allocations, 0);
+  CHECK_LE(heap_after.peak, mock::DEVICE_HEAP_BYTES);
+  return check_failures();
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bench_price_format.cpp
+ * @brief Cost of turning a quote into price-screen text: fixed point against double.
+ *
+ * Runs --rounds passes over a spread of quotes from every magnitude band
+ * through both paths: price_parse() + price_layout(), and the retired
+ * atof() + String(price, 4) + substring() path (legacy_price.h).  Reports
+ * nanoseconds per quote and heap allocations per quote for each.  The
+ * legacy path's std::string keeps short text inline, so it shows no
+ * allocations here where Arduino's String made one per substring().
+ *
+ * This machine has an FPU, so the double path is far cheaper here than on
+ * the ESP8266, where every double operation is a soft-float call; the
+ * figures bound the gap from below.  Fails if the fixed-point path touches
+ * the heap.
+ *
+ *   bench_price_format [--rounds N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+
+#include "check.h"
+#include "display_utils.h"
+#include "legacy_price.h"
+#include "mock_host.h"
+#include "price.h"
+
+#define QUOTES 64
+
+static char            quotes[QUOTES][32];
+static volatile size_t sink;
+
+static double elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char** argv) {
+  int rounds = 20000;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) rounds = atoi(argv[++i]);
+  }
+
+  // From 0.0000xxxx up to 9 999 999.xx, eight decimals each
+  uint64_t seed = 1;
+  for (int i = 0; i < QUOTES; i++) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint64_t whole = (seed >> 40) % 10000000;
+    for (int digits = i % 8; digits < 7; digits++) whole /= 10;
+    snprintf(quotes[i], sizeof(quotes[i]), "%llu.%08u", (unsigned long long)whole,
+             (unsigned)(seed % 100000000));
+  }
+
+  double          n = (double)rounds * QUOTES;
+  mock::HeapStats before;
+  char            text[PRICE_TEXT_SIZE];
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    mock::DeviceScope device;
+    before = mock::heap();
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < QUOTES; i++) {
+        PriceLayout at = price_layout(price_parse(quotes[i]), text);
+        sink += at.large + at.small + (uint8_t)text[0];
+      }
+    }
+  }
+  double   fixed_ns     = elapsed_ns(start) / n;
+  uint64_t fixed_allocs = mock::heap().allocations - before.allocations;
+
+  start = std::chrono::steady_clock::now();
+  {
+    mock::DeviceScope device;
+    before = mock::heap();
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < QUOTES; i++) {
+        LegacyPrice drawn = legacy_price(quotes[i]);
+        sink += drawn.large.size() + drawn.small.size() + (uint8_t)drawn.large[0];
+      }
+    }
+  }
+  double   double_ns     = elapsed_ns(start) / n;
+  uint64_t double_allocs = mock::heap().allocations - before.allocations;
+
+  printf("bench_price_format: %d quotes x %d rounds\n\n", QUOTES, rounds);
+  printf("                 %12s %12s\n", "fixed", "double");
+  printf("ns/quote         %12.1f %12.1f\n", fixed_ns, double_ns);
+  printf("allocations/quote %11.2f %12.2f\n\n", fixed_allocs / n, double_allocs / n);
+
+  CHECK_EQ(fixed_allocs, 0);
+  return check_failures();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file bench_tick_history.cpp
+ * @brief Memory and insert cost of TickHistory against a plain price_t ring.
+ *
+ * Pushes --samples ticks of a BTC-like random walk (up to ±300 ticks of
+ * $0.01 per sample) into a TickHistory and into the fixed price_t array the
+ * delta encoding replaces, sized to hold the same number of samples.
+ * Reports bytes per sample held, ns per push, and ns per lowest()/highest()
+ * query for both.  Fails unless the delta ring holds samples in under half
+ * the bytes of the array and agrees with it on every sample.
+ *
+ *   bench_tick_history [--samples N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "check.h"
+#include "price.h"
+#include "tick_history.h"
+
+#define ARRAY_CAPACITY 1024
+#define WALK_TICKS     300
+
+// A block holds its base plus at most one sample per data byte
+static_assert(TICK_HISTORY_BLOCKS * (TICK_HISTORY_BLOCK_BYTES + 1) <= ARRAY_CAPACITY,
+              "ARRAY_CAPACITY must cover the most samples a TickHistory can hold");
+
+/// The straightforward history: one price_t per sample, min/max by scanning.
+class ArrayHistory {
+ public:
+  explicit ArrayHistory(uint16_t capacity) : capacity_(capacity) {}
+
+  void push(price_t price) {
+    samples_[(first_ + size_) % capacity_] = price;
+    if (size_ < capacity_) size_++;
+    else                   first_ = (first_ + 1) % capacity_;
+  }
+
+  price_t at(uint16_t i) const { return samples_[(first_ + i) % capacity_]; }
+  uint16_t size() const { return size_; }
+  size_t bytes() const { return capacity_ * sizeof(price_t) + 3 * sizeof(uint16_t); }
+
+  price_t lowest() const {
+    price_t lo = at(0);
+    for (uint16_t i = 1; i < size_; i++) lo = (at(i) < lo) ? at(i) : lo;
+    return lo;
+  }
+  price_t highest() const {
+    price_t hi = at(0);
+    for (uint16_t i = 1; i < size_; i++) hi = (at(i) > hi) ? at(i) : hi;
+    return hi;
+  }
+
+ private:
+  price_t  samples_[ARRAY_CAPACITY];
+  uint16_t capacity_;
+  uint16_t first_ = 0;
+  uint16_t size_  = 0;
+};
+
+static volatile price_t sink;
+
+static double elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char** argv) {
+  int samples = 1000000;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) samples = atoi(argv[++i]);
+  }
+
+  // The walk, generated up front so both histories time pushes only
+  price_t* walk  = new price_t[samples];
+  price_t  price = PRICE_UNITS(60950);
+  uint64_t seed  = 1;
+  for (int i = 0; i < samples; i++) {
+    seed   = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    price += ((int64_t)((seed >> 33) % (2 * WALK_TICKS + 1)) - WALK_TICKS) * (PRICE_SCALE / 100);
+    walk[i] = price;
+  }
+
+  static TickHistory history;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < samples; i++) history.push(walk[i]);
+  double delta_push_ns = elapsed_ns(start) / samples;
+
+  // The array gets exactly as many slots as the delta ring ended up holding
+  static ArrayHistory array(history.size());
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < samples; i++) array.push(walk[i]);
+  double array_push_ns = elapsed_ns(start) / samples;
+
+  const int queries = 10000;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++) sink = history.lowest() + history.highest();
+  double delta_query_ns = elapsed_ns(start) / queries;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < queries; i++) sink = array.lowest() + array.highest();
+  double array_query_ns = elapsed_ns(start) / queries;
+
+  double delta_bytes = (double)sizeof(TickHistory) / history.size();
+  double array_bytes = (double)array.bytes() / array.size();
+
+  printf("bench_tick_history: %d samples, %u held (%d x %d-byte blocks)\n\n", samples,
+         history.size(), TICK_HISTORY_BLOCKS, TICK_HISTORY_BLOCK_BYTES);
+  printf("                      %10s %10s\n", "delta", "array");
+  printf("bytes/sample          %10.2f %10.2f\n", delta_bytes, array_bytes);
+  printf("bytes/symbol          %10zu %10zu\n", sizeof(TickHistory), array.bytes());
+  printf("ns/push               %10.1f %10.1f\n", delta_push_ns, array_push_ns);
+  printf("ns/lowest+highest     %10.1f %10.1f\n\n", delta_query_ns, array_query_ns);
+
+  // Same samples, same extremes
+  uint16_t i        = 0;
+  int      mismatch = 0;
+  history.for_each([&](price_t p) { mismatch += (p != array.at(i++)); });
+  CHECK_EQ(i, array.size());
+  CHECK_EQ(mismatch, 0);
+  CHECK_EQ(history.lowest(), array.lowest());
+  CHECK_EQ(history.highest(), array.highest());
+  CHECK(delta_bytes * 2 < array_bytes);
+
+  delete[] walk;
+  return check_failures();
+}
@@ -0,0 +1,207 @@
+/**
+ * @file Adafruit_GFX.cpp
+ * @brief Drawing primitives and the text cell of the GFX stand-in.
+ */
+
+#include "Adafruit_GFX.h"
+
+#include <new>
+#include <utility>
+
+/// 5 column bytes per printable ASCII character (0x20–0x7E), bit 0 at the top.
+extern const uint8_t glcd_font[95 * 5];
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+    : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (h < 0) {
+    y += h + 1;
+    h  = -h;
+  }
+  for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (w < 0) {
+    x += w + 1;
+    w  = -w;
+  }
+  for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+
+  int16_t dx    = x1 - x0;
+  int16_t dy    = abs(y1 - y0);
+  int16_t err   = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+
+  for (; x0 <= x1; x0++) {
+    if (steep) drawPixel(y0, x0, color);
+    else       drawPixel(x0, y0, color);
+    err -= dy;
+    if (err < 0) {
+      y0  += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y, h, color);
+  drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                                 uint16_t color) {
+  int16_t max_radius = ((w < h) ? w : h) / 2;
+  if (r > max_radius) r = max_radius;
+  drawFastHLine(x + r, y, w - 2 * r, color);
+  drawFastHLine(x + r, y + h - 1, w - 2 * r, color);
+  drawFastVLine(x, y + r, h - 2 * r, color);
+  drawFastVLine(x + w - 1, y + r, h - 2 * r, color);
+  drawCircleHelper(x + r, y + r, r, 1, color);
+  drawCircleHelper(x + w - r - 1, y + r, r, 2, color);
+  drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
+  drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
+}
+
+void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                                    uint16_t color) {
+  int16_t f     = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x     = 0;
+  int16_t y     = r;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f     += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f     += ddF_x;
+    if (corners & 0x4) {
+      drawPixel(x0 + x, y0 + y, color);
+      drawPixel(x0 + y, y0 + x, color);
+    }
+    if (corners & 0x2) {
+      drawPixel(x0 + x, y0 - y, color);
+      drawPixel(x0 + y, y0 - x, color);
+    }
+    if (corners & 0x8) {
+      drawPixel(x0 - y, y0 + x, color);
+      drawPixel(x0 - x, y0 + y, color);
+    }
+    if (corners & 0x1) {
+      drawPixel(x0 - y, y0 - x, color);
+      drawPixel(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                              uint16_t color) {
+  int16_t byte_width = (w + 7) / 8;
+  uint8_t b          = 0;
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7) b <<= 1;
+      else       b = pgm_read_byte(&bitmap[j * byte_width + i / 8]);
+      if (b & 0x80) drawPixel(x + i, y, color);
+    }
+  }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                            uint8_t size) {
+  drawChar(x, y, c, color, bg, size, size);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                            uint8_t size_x, uint8_t size_y) {
+  if (x >= _width || y >= _height || x + 6 * size_x - 1 < 0 || y + 8 * size_y - 1 < 0) return;
+
+  for (int8_t i = 0; i < 5; i++) {
+    uint8_t line = (c >= 0x20 && c <= 0x7E) ? glcd_font[(c - 0x20) * 5 + i] : 0;
+    for (int8_t j = 0; j < 8; j++, line >>= 1) {
+      if (line & 1) {
+        if (size_x == 1 && size_y == 1) drawPixel(x + i, y + j, color);
+        else fillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+      } else if (bg != color) {
+        if (size_x == 1 && size_y == 1) drawPixel(x + i, y + j, bg);
+        else fillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+      }
+    }
+  }
+  if (bg != color) {
+    if (size_x == 1 && size_y == 1) drawFastVLine(x + 5, y, 8, bg);
+    else fillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x  = 0;
+    cursor_y += textsize_y * 8;
+  } else if (c != '\r') {
+    if (wrap && cursor_x + textsize_x * 6 > _width) {
+      cursor_x  = 0;
+      cursor_y += textsize_y * 8;
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+    cursor_x += textsize_x * 6;
+  }
+  return 1;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// GFXcanvas1
+// ─────────────────────────────────────────────────────────────────────────────
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h)
+    : Adafruit_GFX(w, h), buffer_(new (std::nothrow) uint8_t[((w + 7) / 8) * h]()) {}
+
+GFXcanvas1::~GFXcanvas1() {
+  delete[] buffer_;
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer_ == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  uint8_t* p   = &buffer_[(x / 8) + y * ((WIDTH + 7) / 8)];
+  uint8_t  bit = 0x80 >> (x & 7);
+  if (color) *p |= bit;
+  else       *p &= ~bit;
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (buffer_ == nullptr) return;
+  memset(buffer_, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+  if (buffer_ == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return false;
+  return buffer_[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
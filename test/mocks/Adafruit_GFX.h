@@ -0,0 +1,84 @@
+/**
+ * @file Adafruit_GFX.h
+ * @brief Host stand-in for the Adafruit GFX library.
+ *
+ * The primitives the sketch draws with, following the library's algorithms
+ * (Bresenham lines, midpoint circle corners, the classic 6×8 text cell and
+ * its wrapping) so that frames have the same shape as on the device.  The
+ * glyphs come from glcdfont.cpp, a 5×7 font in the same column layout as
+ * the library's; pixel-exact equality with the device is not a goal, equal
+ * frames on the host for equal input are.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+ public:
+  Adafruit_GFX(int16_t w, int16_t h);
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  virtual void fillScreen(uint16_t color);
+  virtual void invertDisplay(bool) {}
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, uint16_t color);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h,
+                  uint16_t color);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                uint8_t size);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                uint8_t size_x, uint8_t size_y);
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+  void setTextSize(uint8_t s) { setTextSize(s, s); }
+  void setTextSize(uint8_t sx, uint8_t sy) {
+    textsize_x = (sx > 0) ? sx : 1;
+    textsize_y = (sy > 0) ? sy : 1;
+  }
+  void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+  void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+  void setTextWrap(bool w) { wrap = w; }
+
+  int16_t getCursorX() const { return cursor_x; }
+  int16_t getCursorY() const { return cursor_y; }
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+ protected:
+  int16_t  WIDTH, HEIGHT;
+  int16_t  _width, _height;
+  int16_t  cursor_x    = 0;
+  int16_t  cursor_y    = 0;
+  uint16_t textcolor   = 0xFFFF;
+  uint16_t textbgcolor = 0xFFFF;
+  uint8_t  textsize_x  = 1;
+  uint8_t  textsize_y  = 1;
+  bool     wrap        = true;
+};
+
+/// 1-bit off-screen canvas, rows of (w + 7) / 8 bytes, most significant bit leftmost.
+class GFXcanvas1 : public Adafruit_GFX {
+ public:
+  GFXcanvas1(uint16_t w, uint16_t h);
+  ~GFXcanvas1() override;
+
+  GFXcanvas1(const GFXcanvas1&)            = delete;
+  GFXcanvas1& operator=(const GFXcanvas1&) = delete;
+
+  void     drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void     fillScreen(uint16_t color) override;
+  bool     getPixel(int16_t x, int16_t y) const;
+  uint8_t* getBuffer() const { return buffer_; }
+
+ private:
+  uint8_t* buffer_;
+};
@@ -0,0 +1,61 @@
+/**
+ * @file Adafruit_SH110X.cpp
+ * @brief SH1106G framebuffer and full-frame transfer.
+ */
+
+#include "Adafruit_SH110X.h"
+
+#include <new>
+
+Adafruit_SH1106G::Adafruit_SH1106G(uint16_t w, uint16_t h, TwoWire* wire, int8_t,
+                                   uint32_t, uint32_t clock_after)
+    : Adafruit_GFX(w, h), wire_(wire), clock_after_(clock_after) {}
+
+Adafruit_SH1106G::~Adafruit_SH1106G() {
+  delete[] buffer_;
+}
+
+bool Adafruit_SH1106G::begin(uint8_t address, bool) {
+  address_ = address;
+  if (buffer_ == nullptr) buffer_ = new (std::nothrow) uint8_t[WIDTH * ((HEIGHT + 7) / 8)];
+  if (buffer_ == nullptr) return false;
+  clearDisplay();
+  wire_->setClock(clock_after_);
+  return true;
+}
+
+void Adafruit_SH1106G::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (buffer_ == nullptr || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  uint8_t& b   = buffer_[x + (y / 8) * WIDTH];
+  uint8_t  bit = 1 << (y & 7);
+  switch (color) {
+    case SH110X_WHITE:   b |= bit;  break;
+    case SH110X_BLACK:   b &= ~bit; break;
+    case SH110X_INVERSE: b ^= bit;  break;
+  }
+}
+
+void Adafruit_SH1106G::clearDisplay() {
+  if (buffer_ != nullptr) memset(buffer_, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SH1106G::display() {
+  // Per page: set the window at column 2, then the data in 31-byte chunks
+  for (uint8_t page = 0; page < (HEIGHT + 7) / 8; page++) {
+    wire_->beginTransmission(address_);
+    wire_->write(0x00);
+    wire_->write(0xB0 | page);
+    wire_->write(0x10);
+    wire_->write(0x02);
+    wire_->endTransmission();
+
+    const uint8_t* row = buffer_ + page * WIDTH;
+    for (int16_t x = 0; x < WIDTH; x += 31) {
+      int16_t chunk = (WIDTH - x < 31) ? WIDTH - x : 31;
+      wire_->beginTransmission(address_);
+      wire_->write(0x40);
+      wire_->write(row + x, chunk);
+      wire_->endTransmission();
+    }
+  }
+}
@@ -0,0 +1,41 @@
+/**
+ * @file Adafruit_SH110X.h
+ * @brief Host stand-in for the Adafruit SH110X driver (SH1106G only).
+ *
+ * A framebuffer in SH1106 page layout (8 rows per byte, bit 0 on top) that
+ * the sketch draws into and flushes itself through Wire; display() sends
+ * the whole frame the way the library does.
+ */
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SH110X_BLACK   0
+#define SH110X_WHITE   1
+#define SH110X_INVERSE 2
+
+class Adafruit_SH1106G : public Adafruit_GFX {
+ public:
+  Adafruit_SH1106G(uint16_t w, uint16_t h, TwoWire* wire, int8_t reset_pin = -1,
+                   uint32_t clock_during = 400000, uint32_t clock_after = 100000);
+  ~Adafruit_SH1106G() override;
+
+  Adafruit_SH1106G(const Adafruit_SH1106G&)            = delete;
+  Adafruit_SH1106G& operator=(const Adafruit_SH1106G&) = delete;
+
+  /// Allocate the framebuffer, as the library does; false if out of memory.
+  bool begin(uint8_t address = 0x3C, bool reset = true);
+
+  void     drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void     clearDisplay();
+  void     display();
+  uint8_t* getBuffer() { return buffer_; }
+  void     setContrast(uint8_t) {}
+
+ private:
+  TwoWire* wire_;
+  uint32_t clock_after_;
+  uint8_t  address_ = 0x3C;
+  uint8_t* buffer_  = nullptr;
+};
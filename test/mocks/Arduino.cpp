@@ -0,0 +1,290 @@
+/**
+ * @file Arduino.cpp
+ * @brief Virtual clock, Print / Stream / Serial and ESP for the host build.
+ */
+
+#include "Arduino.h"
+
+#include <chrono>
+
+#include "mock_host.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Clock
+// ─────────────────────────────────────────────────────────────────────────────
+
+static uint64_t virtual_us    = 0;
+static uint32_t yield_cost_us = 100;
+static bool     realtime      = false;
+static std::chrono::steady_clock::time_point real_start;
+
+namespace mock {
+
+void clock_reset(uint64_t start_us) {
+  virtual_us = start_us;
+  real_start = std::chrono::steady_clock::now();
+}
+
+void advance_us(uint64_t us) {
+  virtual_us += us;
+}
+
+uint64_t now_us() {
+  if (!realtime) return virtual_us;
+  auto real = std::chrono::steady_clock::now() - real_start;
+  return virtual_us + std::chrono::duration_cast<std::chrono::microseconds>(real).count();
+}
+
+void set_yield_cost_us(uint32_t us) {
+  yield_cost_us = us;
+}
+
+void clock_realtime(bool on) {
+  if (on == realtime) return;
+  if (on) {
+    real_start = std::chrono::steady_clock::now();
+  } else {
+    virtual_us = now_us();
+  }
+  realtime = on;
+}
+
+}  // namespace mock
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)mock::now_us();
+}
+
+unsigned long millis() {
+  return (unsigned long)(uint32_t)(mock::now_us() / 1000);
+}
+
+void delay(unsigned long ms) {
+  mock::advance_us(ms > 0 ? ms * 1000 : yield_cost_us);
+}
+
+void yield() {
+  mock::advance_us(yield_cost_us);
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t len = strlen(src);
+  if (size > 0) {
+    size_t n = (len < size - 1) ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Print
+// ─────────────────────────────────────────────────────────────────────────────
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper* text) {
+  return write(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print(const char* text) {
+  return write(text);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print_number(unsigned long long value, int base, bool negative) {
+  char  buf[8 * sizeof(value) + 2];
+  char* p = buf + sizeof(buf);
+  *--p = '\0';
+  if (base < 2) base = 10;
+  do {
+    int digit = value % base;
+    *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+    value /= base;
+  } while (value > 0);
+  if (negative) *--p = '-';
+  return write(p);
+}
+
+size_t Print::print(unsigned char value, int base) { return print_number(value, base, false); }
+size_t Print::print(unsigned int value, int base)  { return print_number(value, base, false); }
+size_t Print::print(unsigned long value, int base) { return print_number(value, base, false); }
+size_t Print::print(unsigned long long value, int base) { return print_number(value, base, false); }
+size_t Print::print(int value, int base)  { return print((long long)value, base); }
+size_t Print::print(long value, int base) { return print((long long)value, base); }
+
+size_t Print::print(long long value, int base) {
+  if (base != 10) return print_number((unsigned long long)value, base, false);
+  bool negative = value < 0;
+  return print_number(negative ? 0ULL - (unsigned long long)value : value, 10, negative);
+}
+
+size_t Print::print(double value, int digits) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, value);
+  return write(buf);
+}
+
+size_t Print::print(const Printable& value) {
+  return value.printTo(*this);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+size_t Print::printf(const char* format, ...) {
+  char    buf[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write((const uint8_t*)buf, std::min((size_t)n, sizeof(buf) - 1));
+}
+
+size_t Print::printf_P(PGM_P format, ...) {
+  char    buf[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write((const uint8_t*)buf, std::min((size_t)n, sizeof(buf) - 1));
+}
+
+size_t IPAddress::printTo(Print& out) const {
+  size_t n = 0;
+  for (int i = 0; i < 4; i++) {
+    if (i > 0) n += out.print('.');
+    n += out.print((unsigned)(*this)[i]);
+  }
+  return n;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Stream
+// ─────────────────────────────────────────────────────────────────────────────
+
+int Stream::timed_read() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    yield();
+  } while (millis() - start < timeout_);
+  return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t n = 0;
+  while (n < length) {
+    int c = timed_read();
+    if (c < 0) break;
+    buffer[n++] = (char)c;
+  }
+  return n;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+  size_t n = 0;
+  while (n < length) {
+    int c = timed_read();
+    if (c < 0 || c == terminator) break;
+    buffer[n++] = (char)c;
+  }
+  return n;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Serial
+// ─────────────────────────────────────────────────────────────────────────────
+
+HardwareSerial Serial;
+
+static std::string serial_in;
+static size_t      serial_in_pos = 0;
+static std::string serial_out;
+static bool        serial_echo_on = true;
+
+namespace mock {
+
+void serial_input(const char* text) {
+  HostScope host;
+  serial_in.erase(0, serial_in_pos);
+  serial_in_pos = 0;
+  serial_in += text;
+}
+
+const std::string& serial_output() {
+  return serial_out;
+}
+
+void serial_clear() {
+  HostScope host;
+  serial_out.clear();
+}
+
+void serial_echo(bool on) {
+  serial_echo_on = on;
+}
+
+}  // namespace mock
+
+int HardwareSerial::available() {
+  return (int)(serial_in.size() - serial_in_pos);
+}
+
+int HardwareSerial::read() {
+  return (serial_in_pos < serial_in.size()) ? (uint8_t)serial_in[serial_in_pos++] : -1;
+}
+
+int HardwareSerial::peek() {
+  return (serial_in_pos < serial_in.size()) ? (uint8_t)serial_in[serial_in_pos] : -1;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  mock::HostScope host;
+  serial_out.append((const char*)buffer, size);
+  if (serial_echo_on) fwrite(buffer, 1, size, stdout);
+  return size;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ESP
+// ─────────────────────────────────────────────────────────────────────────────
+
+EspClass ESP;
+
+uint32_t EspClass::getFreeHeap() {
+  size_t used = mock::heap().bytes;
+  return (used < mock::DEVICE_HEAP_BYTES) ? mock::DEVICE_HEAP_BYTES - (uint32_t)used : 0;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize() {
+  return getFreeHeap();
+}
+
+uint8_t EspClass::getHeapFragmentation() {
+  return 0;
+}
+
+uint32_t EspClass::getFreeContStack() {
+  return 2816;
+}
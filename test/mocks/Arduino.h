@@ -0,0 +1,187 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the ESP8266 Arduino core.
+ *
+ * Only what the sketch uses: flash-string macros (PROGMEM is ordinary
+ * memory on the host), Print / Stream / Serial, and a virtual clock behind
+ * millis() and micros().  The clock only moves when the harness advances it
+ * (mock_host.h), or by a small step on every yield() and delay() call, so a
+ * busy-wait in the sketch still terminates and its cost shows up in time.
+ */
+#pragma once
+
+#include <algorithm>
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "IPAddress.h"
+#include "Printable.h"
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Flash strings (pgmspace)
+// ─────────────────────────────────────────────────────────────────────────────
+
+#define PROGMEM
+#define PGM_P    const char*
+#define PSTR(s)  (s)
+
+class __FlashStringHelper;
+#define F(s)      (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+#define FPSTR(p)  (reinterpret_cast<const __FlashStringHelper*>(p))
+
+#define pgm_read_byte(addr)  (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr)  (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_ptr(addr)   (*reinterpret_cast<const void* const*>(addr))
+
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char* dst, const char* src, size_t size);
+#endif
+
+#define strlen_P        strlen
+#define strcpy_P        strcpy
+#define strncpy_P       strncpy
+#define strlcpy_P       strlcpy
+#define strcmp_P        strcmp
+#define strncmp_P       strncmp
+#define strncasecmp_P   strncasecmp
+#define strstr_P        strstr
+#define memcpy_P        memcpy
+#define snprintf_P      snprintf
+#define sprintf_P       sprintf
+#define vsnprintf_P     vsnprintf
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Core
+// ─────────────────────────────────────────────────────────────────────────────
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+using std::max;
+using std::min;
+
+#define HIGH 1
+#define LOW  0
+#define INPUT  0
+#define OUTPUT 1
+
+// NodeMCU pin names
+#define D1 5
+#define D2 4
+#define LED_BUILTIN 2
+#define BUILTIN_LED 2
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Print / Stream
+// ─────────────────────────────────────────────────────────────────────────────
+
+class Print {
+ public:
+  virtual ~Print() = default;
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t write(const char* text) { return text ? write((const uint8_t*)text, strlen(text)) : 0; }
+  size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+  size_t print(const __FlashStringHelper* text);
+  size_t print(const char* text);
+  size_t print(char c);
+  size_t print(unsigned char value, int base = 10);
+  size_t print(int value, int base = 10);
+  size_t print(unsigned int value, int base = 10);
+  size_t print(long value, int base = 10);
+  size_t print(unsigned long value, int base = 10);
+  size_t print(long long value, int base = 10);
+  size_t print(unsigned long long value, int base = 10);
+  size_t print(double value, int digits = 2);
+  size_t print(const Printable& value);
+
+  size_t println();
+  template <class T>
+  size_t println(const T& value) { size_t n = print(value); return n + println(); }
+  template <class T>
+  size_t println(const T& value, int format) {
+    size_t n = print(value, format);
+    return n + println();
+  }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  size_t printf_P(PGM_P format, ...) __attribute__((format(printf, 2, 3)));
+
+  virtual void flush() {}
+
+ private:
+  size_t print_number(unsigned long long value, int base, bool negative);
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read()      = 0;
+  virtual int peek()      = 0;
+
+  void          setTimeout(unsigned long timeout_ms) { timeout_ = timeout_ms; }
+  unsigned long getTimeout() const { return timeout_; }
+
+  size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+  size_t readBytesUntil(char terminator, char* buffer, size_t length);
+  size_t readBytesUntil(char terminator, uint8_t* buffer, size_t length) {
+    return readBytesUntil(terminator, (char*)buffer, length);
+  }
+
+ protected:
+  /// read(), waiting up to the timeout; yield() advances the virtual clock.
+  int timed_read();
+
+  unsigned long timeout_ = 1000;
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  int  available() override;
+  int  read() override;
+  int  peek() override;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// ESP
+// ─────────────────────────────────────────────────────────────────────────────
+
+class EspClass {
+ public:
+  uint32_t getFreeHeap();
+  uint32_t getMaxFreeBlockSize();
+  uint8_t  getHeapFragmentation();
+  uint32_t getFreeContStack();
+  void     resetFreeContStack() {}
+  uint32_t getCycleCount() { return micros() * 80; }
+  uint32_t getChipId() { return 0x00C0FFEE; }
+  void     restart() {}
+};
+
+extern EspClass ESP;
@@ -0,0 +1,14 @@
+/**
+ * @file ESP8266HTTPClient.h
+ * @brief Host stand-in for the ESP8266 HTTP client: only its status code constants.
+ */
+#pragma once
+
+enum t_http_codes {
+  HTTP_CODE_OK                    = 200,
+  HTTP_CODE_NO_CONTENT            = 204,
+  HTTP_CODE_BAD_REQUEST           = 400,
+  HTTP_CODE_NOT_FOUND             = 404,
+  HTTP_CODE_TOO_MANY_REQUESTS     = 429,
+  HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+};
@@ -0,0 +1,48 @@
+/**
+ * @file ESP8266WiFi.h
+ * @brief Host stand-in for the ESP8266 WiFi station and resolver, on mock_network.h.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "WiFiClient.h"
+
+typedef enum {
+  WL_IDLE_STATUS     = 0,
+  WL_NO_SSID_AVAIL   = 1,
+  WL_CONNECTED       = 3,
+  WL_CONNECT_FAILED  = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED    = 7,
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } WiFiMode_t;
+
+class ESP8266WiFiClass {
+ public:
+  wl_status_t begin(const char* ssid, const char* password, int32_t channel = 0,
+                    const uint8_t* bssid = nullptr, bool connect = true);
+  wl_status_t status();
+  bool        isConnected() { return status() == WL_CONNECTED; }
+
+  bool persistent(bool) { return true; }
+  bool mode(WiFiMode_t) { return true; }
+  bool setAutoReconnect(bool) { return true; }
+  bool config(IPAddress local, IPAddress gateway, IPAddress subnet,
+              IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+
+  IPAddress localIP()   { return IPAddress(192, 168, 1, 50); }
+  IPAddress gatewayIP() { return IPAddress(192, 168, 1, 1); }
+  IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+  IPAddress dnsIP(uint8_t = 0) { return IPAddress(192, 168, 1, 1); }
+  uint8_t*  BSSID();
+  int32_t   channel() { return 6; }
+  int32_t   RSSI() { return -58; }
+
+  /// Resolve @p host, waiting at most @p timeout_ms for the DNS server.
+  int hostByName(const char* host, IPAddress& ip, uint32_t timeout_ms);
+  int hostByName(const char* host, IPAddress& ip) { return hostByName(host, ip, 10000); }
+};
+
+extern ESP8266WiFiClass WiFi;
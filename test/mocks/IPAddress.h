@@ -0,0 +1,26 @@
+/**
+ * @file IPAddress.h
+ * @brief Host stand-in for the Arduino IPv4 address class.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "Printable.h"
+
+class IPAddress : public Printable {
+ public:
+  IPAddress() = default;
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+      : address_((uint32_t)a | (uint32_t)b << 8 | (uint32_t)c << 16 | (uint32_t)d << 24) {}
+  IPAddress(uint32_t address) : address_(address) {}
+
+  operator uint32_t() const { return address_; }
+  bool    isSet() const { return address_ != 0; }
+  uint8_t operator[](int i) const { return (uint8_t)(address_ >> (8 * i)); }
+
+  size_t printTo(Print& out) const override;
+
+ private:
+  uint32_t address_ = 0;
+};
@@ -0,0 +1,60 @@
+/**
+ * @file LiquidCrystal_I2C.cpp
+ * @brief Character RAM of the emulated 16×2 LCD.
+ */
+
+#include "LiquidCrystal_I2C.h"
+
+#include "mock_host.h"
+
+#define LCD_MAX_ROWS    4
+#define LCD_MAX_COLUMNS 40
+
+static char     ddram[LCD_MAX_ROWS][LCD_MAX_COLUMNS];
+static uint8_t  visible_columns = 16;
+static uint64_t writes          = 0;
+
+LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t, uint8_t columns, uint8_t rows)
+    : columns_(columns), rows_(rows) {}
+
+void LiquidCrystal_I2C::init() {
+  visible_columns = columns_;
+  clear();
+}
+
+void LiquidCrystal_I2C::clear() {
+  memset(ddram, ' ', sizeof(ddram));
+  column_ = row_ = 0;
+}
+
+void LiquidCrystal_I2C::setCursor(uint8_t column, uint8_t row) {
+  column_ = column;
+  row_    = (row < rows_) ? row : rows_ - 1;
+}
+
+void LiquidCrystal_I2C::createChar(uint8_t, uint8_t*) {}
+
+size_t LiquidCrystal_I2C::write(uint8_t c) {
+  if (row_ < LCD_MAX_ROWS && column_ < LCD_MAX_COLUMNS) ddram[row_][column_] = (char)c;
+  column_++;
+  writes++;
+  return 1;
+}
+
+namespace mock {
+
+std::string lcd_row(uint8_t row) {
+  HostScope   host;
+  std::string text(ddram[row], visible_columns);
+  for (char& c : text) {
+    if (c == 8) c = '^';
+    if (c == 9) c = 'v';
+  }
+  return text;
+}
+
+uint64_t lcd_writes() {
+  return writes;
+}
+
+}  // namespace mock
@@ -0,0 +1,33 @@
+/**
+ * @file LiquidCrystal_I2C.h
+ * @brief Host stand-in for the LiquidCrystal I2C library.
+ *
+ * Keeps the character RAM of the visible rows so a test can read back what
+ * the sketch wrote (mock_host.h, lcd_row()).
+ */
+#pragma once
+
+#include <Arduino.h>
+
+class LiquidCrystal_I2C : public Print {
+ public:
+  LiquidCrystal_I2C(uint8_t address, uint8_t columns, uint8_t rows);
+
+  void init();
+  void begin() { init(); }
+  void backlight() {}
+  void noBacklight() {}
+  void clear();
+  void home() { setCursor(0, 0); }
+  void setCursor(uint8_t column, uint8_t row);
+  void createChar(uint8_t location, uint8_t charmap[]);
+
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+ private:
+  uint8_t columns_;
+  uint8_t rows_;
+  uint8_t column_ = 0;
+  uint8_t row_    = 0;
+};
@@ -0,0 +1,82 @@
+/**
+ * @file LittleFS.cpp
+ * @brief In-memory LittleFS image shared by every File handle.
+ */
+
+#include "LittleFS.h"
+
+#include <map>
+
+#include "mock_host.h"
+
+FS LittleFS;
+
+namespace {
+std::map<std::string, std::string> files;
+}
+
+namespace mock {
+
+void fs_reset() {
+  HostScope host;
+  files.clear();
+}
+
+}  // namespace mock
+
+int File::read() {
+  if (available() <= 0) return -1;
+  return (uint8_t)(*data_)[pos_++];
+}
+
+int File::peek() {
+  if (available() <= 0) return -1;
+  return (uint8_t)(*data_)[pos_];
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (n < size && available() > 0) buffer[n++] = (uint8_t)read();
+  return n;
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+  if (data_ == nullptr || !writing_) return 0;
+  mock::HostScope host;
+  data_->append((const char*)buffer, size);
+  return size;
+}
+
+bool FS::begin() {
+  return true;
+}
+
+File FS::open(const char* path, const char* mode) {
+  mock::HostScope host;
+  if (mode[0] == 'w') {
+    std::string& data = files[path];
+    data.clear();
+    return File(&data, true);
+  }
+  auto file = files.find(path);
+  if (file == files.end()) return File();
+  return File(&file->second, mode[0] == 'a');
+}
+
+bool FS::exists(const char* path) {
+  return files.count(path) > 0;
+}
+
+bool FS::remove(const char* path) {
+  mock::HostScope host;
+  return files.erase(path) > 0;
+}
+
+bool FS::rename(const char* from, const char* to) {
+  mock::HostScope host;
+  auto file = files.find(from);
+  if (file == files.end()) return false;
+  files[to] = std::move(file->second);
+  files.erase(from);
+  return true;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file LittleFS.h
+ * @brief Host stand-in for the ESP8266 LittleFS filesystem: an in-memory image.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <string>
+
+class File : public Stream {
+ public:
+  File() = default;
+  File(std::string* data, bool writing) : data_(data), writing_(writing) {}
+
+  operator bool() const { return data_ != nullptr; }
+  size_t size() const { return data_ ? data_->size() : 0; }
+  void   close() { data_ = nullptr; }
+
+  int    available() override { return data_ ? (int)(data_->size() - pos_) : 0; }
+  int    read() override;
+  int    peek() override;
+  size_t read(uint8_t* buffer, size_t size);
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+ private:
+  std::string* data_    = nullptr;
+  size_t       pos_     = 0;
+  bool         writing_ = false;
+};
+
+class FS {
+ public:
+  bool begin();
+  void end() {}
+  File open(const char* path, const char* mode);
+  bool exists(const char* path);
+  bool remove(const char* path);
+  bool rename(const char* from, const char* to);
+};
+
+extern FS LittleFS;
@@ -0,0 +1,15 @@
+/**
+ * @file Printable.h
+ * @brief Host stand-in for the Arduino Printable interface.
+ */
+#pragma once
+
+#include <stddef.h>
+
+class Print;
+
+class Printable {
+ public:
+  virtual ~Printable() = default;
+  virtual size_t printTo(Print& out) const = 0;
+};
@@ -0,0 +1,63 @@
+/**
+ * @file WiFiClient.h
+ * @brief Host stand-in for the ESP8266 TCP client and server, on mock_network.h.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <memory>
+
+namespace mock {
+class Socket;
+}
+
+class Client : public Stream {
+ public:
+  virtual int     connect(IPAddress ip, uint16_t port) = 0;
+  virtual int     connect(const char* host, uint16_t port) = 0;
+  virtual int     read(uint8_t* buffer, size_t size) = 0;
+  virtual uint8_t connected() = 0;
+  virtual void    stop() = 0;
+  virtual operator bool() = 0;
+  using Stream::read;
+};
+
+class WiFiClient : public Client {
+ public:
+  WiFiClient() { timeout_ = 5000; }
+  ~WiFiClient() override = default;
+
+  int     connect(IPAddress ip, uint16_t port) override;
+  int     connect(const char* host, uint16_t port) override;
+  uint8_t connected() override;
+  void    stop() override;
+  operator bool() override { return connected(); }
+
+  int    available() override;
+  int    read() override;
+  int    read(uint8_t* buffer, size_t size) override;
+  int    peek() override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+  void setNoDelay(bool) {}
+
+ protected:
+  /// Open the TCP connection; @p sni is recorded on the socket for TLS.
+  bool open(IPAddress ip, uint16_t port, const char* sni);
+
+  std::shared_ptr<mock::Socket> socket_;
+};
+
+class WiFiServer {
+ public:
+  explicit WiFiServer(uint16_t port) : port_(port) {}
+  void       begin() {}
+  WiFiClient accept() { return WiFiClient(); }
+  WiFiClient available() { return WiFiClient(); }
+
+ private:
+  uint16_t port_;
+};
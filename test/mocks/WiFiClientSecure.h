@@ -0,0 +1,56 @@
+/**
+ * @file WiFiClientSecure.h
+ * @brief Host stand-in for the ESP8266 BearSSL client, on mock_network.h.
+ *
+ * The handshake is not real TLS: it takes the service's handshake_ms (or
+ * resume_ms with a stored session) of virtual time, bounded by the
+ * client's timeout as in BearSSL's _run_until(), and allocates the record
+ * buffers and engine state on the heap the way BearSSL does, so heap
+ * figures include them for as long as the connection is open.
+ */
+#pragma once
+
+#include "WiFiClient.h"
+
+namespace BearSSL {
+
+class Session {
+ public:
+  bool resumable(const char* host) const;
+  void store(const char* host);
+
+ private:
+  char host_[64] = "";
+};
+
+class WiFiClientSecure : public WiFiClient {
+ public:
+  WiFiClientSecure() = default;
+  ~WiFiClientSecure() override;
+
+  WiFiClientSecure(const WiFiClientSecure&)            = delete;
+  WiFiClientSecure& operator=(const WiFiClientSecure&) = delete;
+
+  void setInsecure() {}
+  void setBufferSizes(int recv, int xmit) { recv_ = recv; xmit_ = xmit; }
+  void setSession(Session* session) { session_ = session; }
+
+  /// TLS without SNI: no host name to send.
+  int  connect(IPAddress ip, uint16_t port) override;
+  /// Resolve (without the caller's timeout, as the core does), then TLS with SNI.
+  int  connect(const char* host, uint16_t port) override;
+  void stop() override;
+
+ private:
+  bool handshake(const char* sni);
+  void release();
+
+  int      recv_     = 16384;
+  int      xmit_     = 512;
+  Session* session_  = nullptr;
+  uint8_t* buffers_  = nullptr;
+};
+
+}  // namespace BearSSL
+
+using BearSSL::WiFiClientSecure;
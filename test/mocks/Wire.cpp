@@ -0,0 +1,97 @@
+/**
+ * @file Wire.cpp
+ * @brief I2C transfer log and SH1106 display RAM emulation.
+ */
+
+#include "Wire.h"
+
+#include "mock_host.h"
+
+#define SH1106_ADDRESS 0x3C
+#define SH1106_PAGES   8
+#define SH1106_COLUMNS 132
+
+TwoWire Wire;
+
+static std::vector<mock::WireTransfer> transfers;
+static uint64_t                        total_bytes = 0;
+
+static uint8_t ram[SH1106_PAGES][SH1106_COLUMNS];
+static uint8_t ram_page   = 0;
+static uint8_t ram_column = 0;
+
+/// Apply one transmission to the emulated controller.
+static void sh1106_receive(const uint8_t* data, uint16_t length) {
+  if (length == 0) return;
+  if (data[0] == 0x40) {
+    for (uint16_t i = 1; i < length; i++) {
+      if (ram_column < SH1106_COLUMNS) ram[ram_page][ram_column] = data[i];
+      ram_column++;
+    }
+    return;
+  }
+  // Command stream (control byte 0x00): only addressing is modelled
+  for (uint16_t i = 1; i < length; i++) {
+    uint8_t c = data[i];
+    if      ((c & 0xF0) == 0xB0) ram_page   = c & 0x07;
+    else if ((c & 0xF0) == 0x10) ram_column = (uint8_t)((ram_column & 0x0F) | (c & 0x0F) << 4);
+    else if ((c & 0xF0) == 0x00) ram_column = (uint8_t)((ram_column & 0xF0) | (c & 0x0F));
+  }
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  address_ = address;
+  length_  = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (length_ >= sizeof(buffer_)) return 0;
+  buffer_[length_++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+  size_t n = 0;
+  while (n < size && write(data[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  mock::HostScope host;
+  transfers.push_back({mock::now_us(), address_, length_});
+  total_bytes += length_;
+  if (address_ == SH1106_ADDRESS) sh1106_receive(buffer_, length_);
+  // Bus time: 9 clocks per byte plus the address byte
+  mock::advance_us((uint64_t)(length_ + 1) * 9 * 1000000 / clock_hz_);
+  length_ = 0;
+  return 0;
+}
+
+namespace mock {
+
+const std::vector<WireTransfer>& wire_log() {
+  return transfers;
+}
+
+uint64_t wire_bytes() {
+  return total_bytes;
+}
+
+void wire_clear() {
+  HostScope host;
+  transfers.clear();
+  total_bytes = 0;
+}
+
+uint8_t sh1106_ram(uint8_t page, uint8_t column) {
+  return ram[page][column];
+}
+
+bool sh1106_shows(const uint8_t* frame) {
+  for (uint8_t page = 0; page < SH1106_PAGES; page++) {
+    if (memcmp(&ram[page][2], frame + page * 128, 128) != 0) return false;
+  }
+  return true;
+}
+
+}  // namespace mock
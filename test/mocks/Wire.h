@@ -0,0 +1,32 @@
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the I2C bus: counts bytes and feeds an emulated SH1106.
+ *
+ * Every transmission is logged (mock_host.h, wire_log()).  Writes to the
+ * SH1106 address (0x3C) are also decoded — page and column commands, then
+ * display data — into an emulated display RAM, so a test can check that
+ * what reached the panel is what the framebuffer holds.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+class TwoWire {
+ public:
+  void begin() {}
+  void begin(int sda, int scl) { (void)sda; (void)scl; }
+  void setClock(uint32_t hz) { clock_hz_ = hz; }
+
+  void    beginTransmission(uint8_t address);
+  size_t  write(uint8_t data);
+  size_t  write(const uint8_t* data, size_t size);
+  uint8_t endTransmission(bool stop = true);
+
+ private:
+  uint32_t clock_hz_ = 100000;
+  uint8_t  address_  = 0;
+  uint8_t  buffer_[128];
+  uint16_t length_   = 0;
+};
+
+extern TwoWire Wire;
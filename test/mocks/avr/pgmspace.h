@@ -0,0 +1,7 @@
+/**
+ * @file pgmspace.h
+ * @brief Host stand-in for <avr/pgmspace.h>; the macros live in Arduino.h.
+ */
+#pragma once
+
+#include <Arduino.h>
@@ -0,0 +1,80 @@
+/**
+ * @file heap.cpp
+ * @brief Counting operator new / delete for the heap figures of mock_host.h.
+ */
+
+#include <stdlib.h>
+
+#include <new>
+
+#include "mock_host.h"
+
+namespace {
+
+// Keeps the user block aligned to max_align_t.
+struct alignas(16) Header {
+  size_t   size;
+  uint32_t counted;
+};
+
+mock::HeapStats stats;
+int             device_depth = 0;
+int             host_depth   = 0;
+
+void* allocate(size_t size, bool nothrow) {
+  Header* h = static_cast<Header*>(malloc(sizeof(Header) + size));
+  if (h == nullptr) {
+    if (nothrow) return nullptr;
+    throw std::bad_alloc();
+  }
+  h->size    = size;
+  h->counted = device_depth > 0 && host_depth == 0;
+  if (h->counted) {
+    stats.allocations++;
+    stats.bytes_total += size;
+    stats.bytes       += size;
+    if (stats.bytes > stats.peak) stats.peak = stats.bytes;
+  }
+  return h + 1;
+}
+
+void release(void* p) {
+  if (p == nullptr) return;
+  Header* h = static_cast<Header*>(p) - 1;
+  if (h->counted) {
+    stats.frees++;
+    stats.bytes -= h->size;
+  }
+  free(h);
+}
+
+}  // namespace
+
+namespace mock {
+
+HeapStats heap() {
+  return stats;
+}
+
+void heap_reset_peak() {
+  stats.peak = stats.bytes;
+}
+
+DeviceScope::DeviceScope()  { device_depth++; }
+DeviceScope::~DeviceScope() { device_depth--; }
+HostScope::HostScope()      { host_depth++; }
+HostScope::~HostScope()     { host_depth--; }
+
+}  // namespace mock
+
+void* operator new(size_t size)                                  { return allocate(size, false); }
+void* operator new[](size_t size)                                { return allocate(size, false); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept   { return allocate(size, true); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, true); }
+
+void operator delete(void* p) noexcept                            { release(p); }
+void operator delete[](void* p) noexcept                          { release(p); }
+void operator delete(void* p, size_t) noexcept                    { release(p); }
+void operator delete[](void* p, size_t) noexcept                  { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept     { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept   { release(p); }
@@ -0,0 +1,152 @@
+/**
+ * @file mock_host.h
+ * @brief Test-side controls of the host mocks: clock, heap, stack, Serial and I2C.
+ *
+ * The sketch only ever sees the Arduino API; a test drives the world around
+ * it through these functions (and the network in mock_network.h).
+ *
+ * Heap accounting: every operator new is counted while the harness runs
+ * sketch code (mock::DeviceScope) and the mocks are not doing their own
+ * bookkeeping (mock::HostScope), so the figures are what the sketch and the
+ * libraries it calls would take from the ESP8266 heap.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace mock {
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Clock
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Restart the virtual clock at @p start_us (millis() == start_us / 1000).
+void     clock_reset(uint64_t start_us = 0);
+
+/// Move the virtual clock forward.
+void     advance_us(uint64_t us);
+inline void advance_ms(uint64_t ms) { advance_us(ms * 1000); }
+
+/// Virtual microseconds since clock_reset().
+uint64_t now_us();
+
+/// What one yield() or delay(0) costs in virtual time (default 100 µs).
+void     set_yield_cost_us(uint32_t us);
+
+/**
+ * @brief Let host CPU time flow into micros() as well.
+ *
+ * Off for tests, so that results never depend on the machine.  Benchmarks
+ * turn it on, and the sketch's own phase timings (metrics.h) then measure
+ * how long the code takes on the host.
+ */
+void     clock_realtime(bool on);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Heap
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct HeapStats {
+  uint64_t allocations = 0;   ///< counted operator new calls
+  uint64_t frees       = 0;   ///< counted operator delete calls
+  uint64_t bytes_total = 0;   ///< bytes ever allocated
+  size_t   bytes       = 0;   ///< bytes held now
+  size_t   peak        = 0;   ///< most bytes held at once since heap_reset_peak()
+};
+
+HeapStats heap();
+void      heap_reset_peak();
+
+/// Heap the ESP8266 has left for the sketch once WiFi is up (ESP.getFreeHeap()).
+constexpr uint32_t DEVICE_HEAP_BYTES = 40960;
+
+/// Count allocations made in this scope: the harness runs sketch code inside one.
+struct DeviceScope {
+  DeviceScope();
+  ~DeviceScope();
+};
+
+/// Do not count allocations made in this scope: mock bookkeeping, test code.
+struct HostScope {
+  HostScope();
+  ~HostScope();
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Stack
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Fill the stack below the caller with a known pattern.
+ *
+ * stack_peak(), called later from the same function, reports how far below
+ * that function's frame any call made in between reached: the host's stack
+ * high-water mark of the code under test.  Host frames are not ESP8266
+ * frames, so compare figures with each other, not with the device stack.
+ */
+void   stack_paint();
+size_t stack_peak();
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Serial
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Queue @p text as if typed into the Serial Monitor.
+void               serial_input(const char* text);
+
+/// Everything the sketch printed since the last serial_clear().
+const std::string& serial_output();
+void               serial_clear();
+
+/// Also copy Serial output to stdout (default on, so failing tests show the log).
+void               serial_echo(bool on);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// I2C
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// One Wire transmission: address byte excluded, control byte included.
+struct WireTransfer {
+  uint64_t at_us;
+  uint8_t  address;
+  uint16_t bytes;
+};
+
+const std::vector<WireTransfer>& wire_log();
+uint64_t                         wire_bytes();   ///< sum of wire_log() bytes
+void                             wire_clear();
+
+/// Display RAM of the SH1106 on the bus, as written through Wire: 8 pages × 132 columns.
+uint8_t sh1106_ram(uint8_t page, uint8_t column);
+
+/// True if the visible columns (2–129) of the SH1106 RAM equal @p frame (page layout, 1 KB).
+bool    sh1106_shows(const uint8_t* frame);
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Character LCD
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Row @p row of the LCD as written by the sketch; custom glyphs appear as '^' (8) and 'v' (9).
+std::string lcd_row(uint8_t row);
+
+/// Characters written to the LCD since boot.
+uint64_t    lcd_writes();
+
+// ─────────────────────────────────────────────────────────────────────────────
+// WiFi and flash
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// How long WiFi.begin() takes to associate (default 300 ms).
+void wifi_set_join_ms(uint32_t ms);
+
+/// Drop or restore the association.
+void wifi_set_up(bool up);
+
+/// Empty the LittleFS image.
+void fs_reset();
+
+}  // namespace mock
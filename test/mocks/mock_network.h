@@ -0,0 +1,122 @@
+/**
+ * @file mock_network.h
+ * @brief In-process network for the host build: DNS, TCP/TLS sockets and scripted servers.
+ *
+ * A test registers a Service per host and port; every WiFiClient or
+ * WiFiClientSecure the sketch opens to it gets its own Socket.  Bytes the
+ * service sends carry a delivery time on the virtual clock, so latency,
+ * stalls and trickled responses are all just delays — nothing here sleeps
+ * or spawns a thread.
+ *
+ * Costs that block on the device block here too: a DNS query, the TCP
+ * connect and the TLS handshake advance the virtual clock, each bounded by
+ * the timeout the client passed, exactly where the ESP8266 core would stop
+ * waiting.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <deque>
+#include <string>
+
+namespace mock {
+
+class Service;
+
+/// The server end of one connection.
+class Socket {
+ public:
+  Socket(Service& service, const std::string& host, uint16_t port, const std::string& sni)
+      : service_(service), host_(host), port_(port), sni_(sni) {}
+
+  const std::string& host() const { return host_; }
+  uint16_t           port() const { return port_; }
+
+  /// Name the client sent for SNI; empty for plain TCP or connect(IPAddress) over TLS.
+  const std::string& sni() const { return sni_; }
+
+  /// Bytes the device wrote that the service has not consumed yet.
+  std::string& inbox() { return inbox_; }
+
+  /// Queue @p data for the device, readable @p delay_ms from now and after anything queued before.
+  void send(const std::string& data, uint32_t delay_ms = 0);
+
+  /// Close from the server side once everything queued so far has been delivered,
+  /// and no earlier than @p delay_ms from now.
+  void close(uint32_t delay_ms = 0);
+
+  /// True once the device called stop().
+  bool closed_by_device() const { return device_closed_; }
+
+  // ── Device side (WiFiClient) ──
+  Service& service() { return service_; }
+  size_t   readable();                 ///< bytes due by now
+  int      read_byte(bool consume);    ///< next due byte, or -1
+  bool     server_closed() const;
+  void     device_close() { device_closed_ = true; }
+
+ private:
+  struct Chunk {
+    uint64_t    ready_us;
+    std::string data;
+  };
+
+  Service&          service_;
+  std::string       host_;
+  uint16_t          port_;
+  std::string       sni_;
+  std::string       inbox_;
+  std::deque<Chunk> outbox_;
+  size_t            offset_        = 0;        ///< consumed bytes of outbox_.front()
+  uint64_t          last_ready_us_ = 0;
+  uint64_t          close_at_us_   = UINT64_MAX;
+  bool              device_closed_ = false;
+};
+
+/// A scripted server on one host and port.
+class Service {
+ public:
+  virtual ~Service() = default;
+
+  /// A connection was accepted (after the handshake, for TLS).
+  virtual void on_connect(Socket&) {}
+
+  /// The device wrote to @p socket; the new bytes are at the end of its inbox().
+  virtual void on_data(Socket& socket) = 0;
+
+  /// The device looked for data on @p socket: push anything that is due by now.
+  virtual void on_poll(Socket&) {}
+
+  /// The device closed @p socket.
+  virtual void on_close(Socket&) {}
+
+  uint32_t connect_ms   = 0;      ///< TCP connect time
+  uint32_t handshake_ms = 0;      ///< full TLS handshake
+  uint32_t resume_ms    = 0;      ///< abbreviated handshake with a stored session
+  bool     require_sni  = false;  ///< fail TLS handshakes that name no host (as CDNs do)
+  bool     reachable    = true;   ///< false: connects hang until the client's timeout
+  bool     tls          = false;  ///< TLS port: a plain TCP connect never reaches the service
+};
+
+struct NetStats {
+  uint32_t dns_lookups     = 0;   ///< WiFi.hostByName() calls
+  uint32_t dns_queries     = 0;   ///< lookups not answered from lwIP's table
+  uint32_t connects        = 0;   ///< TCP connections accepted
+  uint32_t tls_handshakes  = 0;   ///< full TLS handshakes completed
+  uint32_t tls_resumptions = 0;   ///< abbreviated handshakes completed
+  uint32_t failures        = 0;   ///< connects or handshakes that failed
+};
+
+/// Forget every service, socket, cached address and counter.
+void network_reset();
+
+/// Serve @p host : @p port with @p service (kept by reference).
+void network_serve(const char* host, uint16_t port, Service& service);
+
+/// Time a DNS query takes (default 20 ms); lwIP answers repeats for @p ttl_ms.
+void dns_configure(uint32_t query_ms, uint32_t ttl_ms = 60000);
+
+const NetStats& net_stats();
+
+}  // namespace mock
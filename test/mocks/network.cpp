@@ -0,0 +1,360 @@
+/**
+ * @file network.cpp
+ * @brief WiFi station, resolver, TCP and TLS clients on the in-process network.
+ */
+
+#include <map>
+#include <string>
+
+#include "ESP8266WiFi.h"
+#include "WiFiClientSecure.h"
+#include "mock_host.h"
+#include "mock_network.h"
+
+// BearSSL's fixed costs (see memory_budget.cpp for the same figures on the device)
+#define TLS_READ_OVERHEAD  325
+#define TLS_WRITE_OVERHEAD 85
+#define TLS_CLIENT_STATE   4096
+#define TLS_STACK          6200
+
+ESP8266WiFiClass WiFi;
+
+namespace {
+
+struct Endpoint {
+  mock::Service* service;
+};
+
+struct Lookup {
+  uint32_t ip;
+  uint64_t cached_until_us;
+};
+
+std::map<std::string, Endpoint> endpoints;     // "host:port"
+std::map<std::string, Lookup>   dns_cache;     // lwIP's table
+std::map<uint32_t, std::string> hosts_by_ip;
+mock::NetStats                  stats;
+uint32_t                        dns_query_ms = 20;
+uint32_t                        dns_ttl_ms   = 60000;
+uint32_t                        join_ms      = 300;
+uint64_t                        joined_at_us = UINT64_MAX;
+bool                            wifi_up      = true;
+uint8_t                         bssid[6]     = {0x02, 0x00, 0x00, 0xBE, 0xEF, 0x01};
+uint8_t*                        tls_stack    = nullptr;
+int                             tls_clients  = 0;
+
+std::string endpoint_key(const std::string& host, uint16_t port) {
+  return host + ":" + std::to_string(port);
+}
+
+/// The address hostByName() hands out for @p host: 10.0.x.y, stable per name.
+uint32_t address_of(const std::string& host) {
+  for (auto& entry : hosts_by_ip) {
+    if (entry.second == host) return entry.first;
+  }
+  uint32_t n  = (uint32_t)hosts_by_ip.size() + 1;
+  uint32_t ip = (uint32_t)IPAddress(10, 0, (uint8_t)(n >> 8), (uint8_t)n);
+  hosts_by_ip[ip] = host;
+  return ip;
+}
+
+bool host_served(const std::string& host) {
+  for (auto& entry : endpoints) {
+    if (entry.first.compare(0, host.size() + 1, host + ":") == 0) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Test controls
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace mock {
+
+void network_reset() {
+  HostScope host;
+  endpoints.clear();
+  dns_cache.clear();
+  hosts_by_ip.clear();
+  stats = NetStats();
+}
+
+void network_serve(const char* host, uint16_t port, Service& service) {
+  HostScope scope;
+  endpoints[endpoint_key(host, port)] = {&service};
+}
+
+void dns_configure(uint32_t query_ms, uint32_t ttl_ms) {
+  dns_query_ms = query_ms;
+  dns_ttl_ms   = ttl_ms;
+}
+
+const NetStats& net_stats() {
+  return stats;
+}
+
+void wifi_set_join_ms(uint32_t ms) {
+  join_ms = ms;
+}
+
+void wifi_set_up(bool up) {
+  wifi_up = up;
+}
+
+// ── Socket ───────────────────────────────────────────────────────────────────
+
+void Socket::send(const std::string& data, uint32_t delay_ms) {
+  HostScope host;
+  uint64_t  ready = now_us() + (uint64_t)delay_ms * 1000;
+  if (ready < last_ready_us_) ready = last_ready_us_;
+  last_ready_us_ = ready;
+  outbox_.push_back({ready, data});
+}
+
+void Socket::close(uint32_t delay_ms) {
+  uint64_t at = now_us() + (uint64_t)delay_ms * 1000;
+  if (at < last_ready_us_) at = last_ready_us_;
+  if (at < close_at_us_) close_at_us_ = at;
+}
+
+size_t Socket::readable() {
+  uint64_t now = now_us();
+  size_t   n   = 0;
+  size_t   off = offset_;
+  for (const Chunk& chunk : outbox_) {
+    if (chunk.ready_us > now) break;
+    n  += chunk.data.size() - off;
+    off = 0;
+  }
+  return n;
+}
+
+int Socket::read_byte(bool consume) {
+  while (!outbox_.empty() && offset_ >= outbox_.front().data.size()) {
+    HostScope host;
+    outbox_.pop_front();
+    offset_ = 0;
+  }
+  if (outbox_.empty() || outbox_.front().ready_us > now_us()) return -1;
+  uint8_t c = (uint8_t)outbox_.front().data[offset_];
+  if (consume) offset_++;
+  return c;
+}
+
+bool Socket::server_closed() const {
+  return now_us() >= close_at_us_;
+}
+
+}  // namespace mock
+
+// ─────────────────────────────────────────────────────────────────────────────
+// WiFi station and resolver
+// ─────────────────────────────────────────────────────────────────────────────
+
+wl_status_t ESP8266WiFiClass::begin(const char*, const char*, int32_t, const uint8_t*, bool) {
+  joined_at_us = mock::now_us() + (uint64_t)join_ms * 1000;
+  return status();
+}
+
+wl_status_t ESP8266WiFiClass::status() {
+  return (wifi_up && mock::now_us() >= joined_at_us) ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+bool ESP8266WiFiClass::config(IPAddress, IPAddress, IPAddress, IPAddress, IPAddress) {
+  return true;
+}
+
+uint8_t* ESP8266WiFiClass::BSSID() {
+  return bssid;
+}
+
+int ESP8266WiFiClass::hostByName(const char* host, IPAddress& ip, uint32_t timeout_ms) {
+  mock::HostScope scope;
+  stats.dns_lookups++;
+  if (status() != WL_CONNECTED) return 0;
+
+  uint64_t now   = mock::now_us();
+  auto     entry = dns_cache.find(host);
+  if (entry != dns_cache.end() && now < entry->second.cached_until_us) {
+    ip = entry->second.ip;
+    return 1;
+  }
+
+  stats.dns_queries++;
+  if (dns_query_ms > timeout_ms || !host_served(host)) {
+    mock::advance_ms(timeout_ms < dns_query_ms ? timeout_ms : dns_query_ms);
+    return 0;
+  }
+  mock::advance_ms(dns_query_ms);
+  ip               = address_of(host);
+  dns_cache[host]  = {(uint32_t)ip, mock::now_us() + (uint64_t)dns_ttl_ms * 1000};
+  return 1;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TCP client
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool WiFiClient::open(IPAddress ip, uint16_t port, const char* sni) {
+  mock::HostScope scope;
+  stop();
+
+  auto host = hosts_by_ip.find((uint32_t)ip);
+  auto end  = (host == hosts_by_ip.end()) ? endpoints.end()
+                                          : endpoints.find(endpoint_key(host->second, port));
+  if (end == endpoints.end() || WiFi.status() != WL_CONNECTED) {
+    stats.failures++;
+    return false;                       // refused
+  }
+
+  mock::Service& service = *end->second.service;
+  if (!service.reachable || service.connect_ms > timeout_) {
+    mock::advance_ms(timeout_);
+    stats.failures++;
+    return false;
+  }
+  mock::advance_ms(service.connect_ms);
+  socket_ = std::make_shared<mock::Socket>(service, host->second, port, sni ? sni : "");
+  stats.connects++;
+  return true;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+  if (!open(ip, port, nullptr)) return 0;
+  mock::HostScope scope;
+  if (!socket_->service().tls) socket_->service().on_connect(*socket_);
+  return 1;
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+  IPAddress ip;
+  if (!WiFi.hostByName(host, ip, timeout_)) return 0;
+  return connect(ip, port);
+}
+
+uint8_t WiFiClient::connected() {
+  if (!socket_) return 0;
+  return available() > 0 || !socket_->server_closed();
+}
+
+void WiFiClient::stop() {
+  if (!socket_) return;
+  mock::HostScope scope;
+  socket_->device_close();
+  socket_->service().on_close(*socket_);
+  socket_.reset();
+}
+
+int WiFiClient::available() {
+  if (!socket_) return 0;
+  mock::HostScope scope;
+  socket_->service().on_poll(*socket_);
+  return (int)socket_->readable();
+}
+
+int WiFiClient::read() {
+  if (available() <= 0) return -1;
+  return socket_->read_byte(true);
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (n < size) {
+    int c = read();
+    if (c < 0) break;
+    buffer[n++] = (uint8_t)c;
+  }
+  return (n > 0) ? (int)n : -1;
+}
+
+int WiFiClient::peek() {
+  if (available() <= 0) return -1;
+  return socket_->read_byte(false);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+  if (!socket_ || socket_->server_closed()) return 0;
+  mock::HostScope scope;
+  socket_->inbox().append((const char*)buffer, size);
+  socket_->service().on_data(*socket_);
+  return size;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// TLS client
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace BearSSL {
+
+bool Session::resumable(const char* host) const {
+  return host != nullptr && host_[0] != '\0' && strcmp(host, host_) == 0;
+}
+
+void Session::store(const char* host) {
+  strlcpy(host_, host ? host : "", sizeof(host_));
+}
+
+WiFiClientSecure::~WiFiClientSecure() {
+  release();
+}
+
+bool WiFiClientSecure::handshake(const char* sni) {
+  mock::Service& service = socket_->service();
+  bool     resumed = session_ != nullptr && session_->resumable(sni);
+  uint32_t cost    = resumed ? service.resume_ms : service.handshake_ms;
+
+  if (cost > timeout_ || (service.require_sni && sni == nullptr)) {
+    mock::advance_ms(cost > timeout_ ? timeout_ : cost);
+    {
+      mock::HostScope scope;
+      stats.failures++;
+    }
+    WiFiClient::stop();
+    return false;
+  }
+  mock::advance_ms(cost);
+
+  // Record buffers and engine state for as long as the connection is open
+  if (tls_clients++ == 0) tls_stack = new uint8_t[TLS_STACK];
+  buffers_ = new uint8_t[recv_ + TLS_READ_OVERHEAD + xmit_ + TLS_WRITE_OVERHEAD + TLS_CLIENT_STATE];
+
+  mock::HostScope scope;
+  if (resumed) stats.tls_resumptions++;
+  else         stats.tls_handshakes++;
+  if (session_ != nullptr) session_->store(sni);
+  service.on_connect(*socket_);
+  return true;
+}
+
+int WiFiClientSecure::connect(IPAddress ip, uint16_t port) {
+  release();
+  if (!open(ip, port, nullptr)) return 0;
+  return handshake(nullptr);
+}
+
+int WiFiClientSecure::connect(const char* host, uint16_t port) {
+  release();
+  IPAddress ip;
+  if (!WiFi.hostByName(host, ip)) return 0;
+  if (!open(ip, port, host)) return 0;
+  return handshake(host);
+}
+
+void WiFiClientSecure::release() {
+  if (buffers_ == nullptr) return;
+  delete[] buffers_;
+  buffers_ = nullptr;
+  if (--tls_clients == 0) {
+    delete[] tls_stack;
+    tls_stack = nullptr;
+  }
+}
+
+void WiFiClientSecure::stop() {
+  WiFiClient::stop();
+  release();
+}
+
+}  // namespace BearSSL
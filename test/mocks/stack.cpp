@@ -0,0 +1,40 @@
+/**
+ * @file stack.cpp
+ * @brief Stack painting for the high-water mark of mock_host.h.
+ */
+
+#include <string.h>
+
+#include "mock_host.h"
+
+// Deeper than anything the sketch reaches from a test's main()
+#define STACK_PAINT_BYTES (256 * 1024)
+#define STACK_PAINT       0xA5
+
+namespace {
+
+const uint8_t* painted_low  = nullptr;
+const uint8_t* painted_high = nullptr;
+
+}  // namespace
+
+namespace mock {
+
+__attribute__((noinline)) void stack_paint() {
+  // Painted while this frame owns the memory; the caller's later calls reuse it
+  uint8_t  area[STACK_PAINT_BYTES];
+  uint8_t* low = area;
+  memset(area, STACK_PAINT, sizeof(area));
+  asm volatile("" : "+r"(low) : : "memory");    // keeps the fill, hides the address
+  painted_low  = low;
+  painted_high = low + STACK_PAINT_BYTES;
+}
+
+__attribute__((noinline)) size_t stack_peak() {
+  if (painted_low == nullptr) return 0;
+  const volatile uint8_t* p = painted_low;
+  while (p < painted_high && *p == STACK_PAINT) p++;
+  return painted_high - (const uint8_t*)p;
+}
+
+}  // namespace mock
@@ -0,0 +1,57 @@
+/**
+ * @file check.h
+ * @brief The few assertion macros the host tests need.
+ *
+ * A failed CHECK prints where and why and counts the failure; the test
+ * carries on, so one run reports every broken expectation.  main() returns
+ * check_failures(), which is what ctest looks at.
+ */
+#pragma once
+
+#include <stdio.h>
+
+#include <string>
+
+inline int& check_failure_count() {
+  static int failures = 0;
+  return failures;
+}
+
+inline int check_failures() {
+  int failures = check_failure_count();
+  printf(failures == 0 ? "PASS\n" : "FAIL: %d check(s)\n", failures);
+  return failures;
+}
+
+#define CHECK(cond)                                                         \
+  do {                                                                      \
+    if (!(cond)) {                                                          \
+      printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);       \
+      check_failure_count()++;                                              \
+    }                                                                       \
+  } while (0)
+
+/// CHECK(a op b) that prints both sides (as long long) when it fails.
+#define CHECK_OP(a, op, b)                                                  \
+  do {                                                                      \
+    long long check_a_ = (long long)(a), check_b_ = (long long)(b);         \
+    if (!(check_a_ op check_b_)) {                                          \
+      printf("%s:%d: CHECK failed: %s %s %s (%lld vs %lld)\n", __FILE__,    \
+             __LINE__, #a, #op, #b, check_a_, check_b_);                    \
+      check_failure_count()++;                                              \
+    }                                                                       \
+  } while (0)
+
+#define CHECK_EQ(a, b) CHECK_OP(a, ==, b)
+#define CHECK_LE(a, b) CHECK_OP(a, <=, b)
+#define CHECK_GE(a, b) CHECK_OP(a, >=, b)
+
+#define CHECK_STR(a, b)                                                     \
+  do {                                                                      \
+    std::string check_a_(a), check_b_(b);                                   \
+    if (check_a_ != check_b_) {                                             \
+      printf("%s:%d: CHECK failed: %s == %s (\"%s\" vs \"%s\")\n", __FILE__, \
+             __LINE__, #a, #b, check_a_.c_str(), check_b_.c_str());         \
+      check_failure_count()++;                                              \
+    }                                                                       \
+  } while (0)
@@ -0,0 +1,43 @@
+/**
+ * @file legacy_price.h
+ * @brief The double-based price text the sketch drew before price_t, for comparison.
+ *
+ * A transcription of the retired draw_price(): the quote parsed to double,
+ * String(price, 4), then cut by range with indexOf('.') / substring().
+ * String(price, 4) is dtostrf(), which prints like "%.4f".
+ */
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+/// What the old draw_price() printed, and where.
+struct LegacyPrice {
+  int16_t     x;          ///< cursor of the size-3 text
+  std::string large;      ///< text at size 3
+  int16_t     small_x;    ///< cursor of the size-2 text
+  std::string small;      ///< text at size 2; empty if none
+};
+
+inline LegacyPrice legacy_price(const char* quote) {
+  double price = atof(quote);
+  char   s[64];
+  snprintf(s, sizeof(s), "%.4f", price);
+  std::string text(s);
+  int         dec_index = (int)(strchr(s, '.') - s);
+
+  if (price >= 1000000) return {0, text.substr(0, dec_index), 0, ""};
+  if (price >= 100000)  return {5, text.substr(0, dec_index), 0, ""};
+  if (price >= 1000) {
+    return {5, text.substr(0, dec_index), (int16_t)(dec_index * 17 + 5),
+            text.substr(dec_index, 7 - dec_index)};
+  }
+  if (price >= 10) {
+    return {20, text.substr(0, dec_index), (int16_t)(dec_index * 17 + 20),
+            text.substr(dec_index, 6 - dec_index)};
+  }
+  return {5, text, 0, ""};
+}
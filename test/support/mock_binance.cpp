@@ -0,0 +1,195 @@
+/**
+ * @file mock_binance.cpp
+ * @brief HTTP/1.1 responses of the scripted Binance REST API.
+ */
+
+#include "mock_binance.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mock_host.h"
+
+static const char* const API_HOSTS[] = {
+  "api.binance.com", "api1.binance.com", "api2.binance.com", "api3.binance.com",
+};
+
+std::string http_date(uint32_t epoch) {
+  static const char* const DAYS[]   = {"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"};
+  static const char* const MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                       "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  // Civil date from days since 1970-01-01 (Howard Hinnant's algorithm)
+  int64_t  days = epoch / 86400;
+  uint32_t secs = epoch % 86400;
+  int64_t  z    = days + 719468;
+  int64_t  era  = z / 146097;
+  uint32_t doe  = (uint32_t)(z - era * 146097);
+  uint32_t yoe  = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy  = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp   = (5 * doy + 2) / 153;
+  uint32_t day  = doy - (153 * mp + 2) / 5 + 1;
+  uint32_t mon  = mp < 10 ? mp + 3 : mp - 9;
+  int64_t  year = (int64_t)yoe + era * 400 + (mon <= 2);
+
+  char text[40];
+  snprintf(text, sizeof(text), "%s, %02u %s %04lld %02u:%02u:%02u GMT", DAYS[days % 7], day,
+           MONTHS[mon - 1], (long long)year, secs / 3600, secs / 60 % 60, secs % 60);
+  return text;
+}
+
+MockBinance::MockBinance() {
+  for (const char* host : API_HOSTS) mock::network_serve(host, 443, *this);
+  connect_ms   = 40;
+  handshake_ms = 450;
+  resume_ms    = 130;
+  tls          = true;
+  require_sni  = true;
+  set_price("BTCUSDT", "60950.01000000");
+  set_price("ETHUSDT", "2450.50000000");
+  set_open("BTCUSDT", "60000.00000000");
+  set_open("ETHUSDT", "2500.00000000");
+}
+
+void MockBinance::set_price(const std::string& pair, const std::string& price) {
+  mock::HostScope host;
+  prices_[pair] = price;
+}
+
+void MockBinance::set_open(const std::string& pair, const std::string& open) {
+  mock::HostScope host;
+  opens_[pair] = open;
+}
+
+void MockBinance::on_connect(mock::Socket&) {
+  connections++;
+}
+
+void MockBinance::on_data(mock::Socket& socket) {
+  std::string& inbox = socket.inbox();
+  size_t       end;
+  while ((end = inbox.find("\r\n\r\n")) != std::string::npos) {
+    std::string head = inbox.substr(0, end);
+    inbox.erase(0, end + 4);
+
+    // "GET <path> HTTP/1.1"
+    size_t      space = head.find(' ');
+    std::string path  = head.substr(space + 1, head.find(' ', space + 1) - space - 1);
+    int         status;
+    std::string body  = respond(path, &status);
+
+    bool close = close_every != 0 && ++responses_ % close_every == 0;
+    char head_out[256];
+    snprintf(head_out, sizeof(head_out),
+             "HTTP/1.1 %d %s\r\n"
+             "Content-Type: application/json;charset=UTF-8\r\n"
+             "Date: %s\r\n"
+             "Connection: %s\r\n",
+             status, status == 200 ? "OK" : "Not Found",
+             http_date(epoch_at_boot + (uint32_t)(mock::now_us() / 1000000)).c_str(),
+             close ? "close" : "keep-alive");
+
+    std::string response = head_out;
+    if (chunked) {
+      // Two chunks, so the decoder sees a boundary inside the JSON
+      size_t half = body.size() / 2;
+      char   size[24];
+      response += "Transfer-Encoding: chunked\r\n\r\n";
+      snprintf(size, sizeof(size), "%zx\r\n", half);
+      response += size + body.substr(0, half) + "\r\n";
+      snprintf(size, sizeof(size), "%zx\r\n", body.size() - half);
+      response += size + body.substr(half) + "\r\n0\r\n\r\n";
+    } else {
+      response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    uint32_t delay = latency_ms;
+    if (stall_count > 0) {
+      stall_count--;
+      delay += stall_ms;
+    }
+    size_t from = 0;
+    if (header_stall_ms > 0) {
+      // The status line now, the rest of the headers after the stall
+      from = response.find("\r\n") + 2;
+      socket.send(response.substr(0, from), delay);
+      delay += header_stall_ms;
+    }
+    if (body_stall_ms > 0) {
+      // Headers and the first half of the body now, the rest after the stall
+      size_t head  = response.find("\r\n\r\n") + 4;
+      size_t split = head + (response.size() - head) / 2;
+      socket.send(response.substr(from, split - from), delay);
+      socket.send(response.substr(split), delay + body_stall_ms);
+    } else {
+      socket.send(response.substr(from), delay);
+    }
+    if (close) socket.close();
+  }
+}
+
+std::string MockBinance::respond(const std::string& path, int* status) {
+  *status = 200;
+  if (path.rfind("/api/v3/ticker/price?symbols=", 0) == 0) {
+    ticker_requests++;
+    return batch(path, "price", prices_);
+  }
+  if (path.rfind("/api/v3/ticker/tradingDay?symbols=", 0) == 0) {
+    trading_day_requests++;
+    return batch(path, "openPrice", opens_);
+  }
+  if (path.rfind("/api/v3/klines?", 0) == 0) {
+    klines_requests++;
+    return klines(path);
+  }
+  other_requests++;
+  *status = 404;
+  return "{\"code\":-1121,\"msg\":\"Invalid symbol.\"}";
+}
+
+/// [{"symbol":"BTCUSDT","<field>":"..."},...] for each pair named in @p path.
+std::string MockBinance::batch(const std::string& path, const char* field,
+                               const std::map<std::string, std::string>& values) {
+  std::string body = "[";
+  for (const auto& entry : values) {
+    if (path.find("%22" + entry.first + "%22") == std::string::npos) continue;
+    if (body.size() > 1) body += ",";
+    body += "{\"symbol\":\"" + entry.first + "\",\"" + field + "\":\"" + entry.second + "\"";
+    if (strcmp(field, "openPrice") == 0) {
+      body += ",\"highPrice\":\"0\",\"lowPrice\":\"0\",\"lastPrice\":\"" + prices_[entry.first]
+            + "\",\"volume\":\"1000.00000000\",\"closeTime\":1760659199999";
+    }
+    body += "}";
+  }
+  return body + "]";
+}
+
+/// limit= candles around the current price of symbol=, oldest first.
+std::string MockBinance::klines(const std::string& path) {
+  mock::HostScope host;
+  size_t      at    = path.find("symbol=");
+  std::string pair  = path.substr(at + 7, path.find('&', at) - at - 7);
+  size_t      limit = strtoul(path.c_str() + path.find("limit=") + 6, nullptr, 10);
+  double      price = atof(prices_[pair].c_str());
+  if (klines_limit > 0) limit = klines_limit;
+
+  std::string body = "[";
+  uint64_t    time = (uint64_t)epoch_at_boot * 1000 - limit * 900000;
+  for (size_t i = 0; i < limit; i++, time += 900000) {
+    // A slow zig-zag: every candle differs, nothing depends on the host's libm.
+    // With klines_drift the zig-zag climbs (or falls) to the current price.
+    double base  = price * (1.0 - klines_drift * (double)(limit - 1 - i));
+    double open  = base * (1.0 + 0.001 * (double)((i * 7) % 11) - 0.005);
+    double close = base * (1.0 + 0.001 * (double)((i * 5 + 3) % 11) - 0.005);
+    double high  = (open > close ? open : close) * 1.002;
+    double low   = (open < close ? open : close) * 0.998;
+    char   candle[200];
+    snprintf(candle, sizeof(candle),
+             "%s[%llu,\"%.8f\",\"%.8f\",\"%.8f\",\"%.8f\",\"12.5\","
+             "%llu,\"0\",10,\"0\",\"0\",\"0\"]",
+             i ? "," : "", (unsigned long long)time, open, high, low, close,
+             (unsigned long long)(time + 899999));
+    body += candle;
+  }
+  return body + "]";
+}
@@ -0,0 +1,72 @@
+/**
+ * @file mock_binance.h
+ * @brief Scripted Binance REST API for the host tests.
+ *
+ * Answers the three endpoints the sketch uses — ticker/price,
+ * ticker/tradingDay and klines — from a price table the test controls, over
+ * HTTP/1.1 keep-alive with a Date header taken from the virtual clock.
+ * Delays, stalls and server-side closes are all options on the service.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "mock_network.h"
+
+class MockBinance : public mock::Service {
+ public:
+  /// Serve api.binance.com:443 (and the fallback hosts) with this instance,
+  /// with connect and handshake times of a nearby CDN edge.
+  MockBinance();
+
+  /// Current price of @p pair ("BTCUSDT"), as Binance would quote it.
+  void set_price(const std::string& pair, const std::string& price);
+
+  /// Daily open of @p pair returned by ticker/tradingDay.
+  void set_open(const std::string& pair, const std::string& open);
+
+  /// UTC epoch (seconds) of virtual time 0, for the Date header.
+  uint32_t epoch_at_boot = 1760572800;          // 2025-10-16 00:00:00
+
+  uint32_t latency_ms      = 30;      ///< request → first byte of the response
+  uint32_t stall_ms        = 0;       ///< extra delay on the next stall_count responses
+  uint32_t stall_count     = 0;
+  uint32_t header_stall_ms = 0;       ///< headers after the status line arrive this much later
+  uint32_t body_stall_ms   = 0;       ///< the second half of every body arrives this much later
+  bool     chunked         = false;   ///< chunked transfer encoding instead of Content-Length
+  uint32_t close_every     = 0;       ///< answer "Connection: close" on every Nth response
+  uint32_t klines_limit    = 0;       ///< candles per klines response, overriding limit=; 0 = off
+  double   klines_drift    = 0;       ///< candle-to-candle trend, as a fraction of the price
+
+  // ── Counters ──
+  uint32_t ticker_requests      = 0;
+  uint32_t trading_day_requests = 0;
+  uint32_t klines_requests      = 0;
+  uint32_t other_requests       = 0;
+  uint32_t connections          = 0;   ///< sockets accepted (after TLS)
+
+  uint32_t requests() const {
+    return ticker_requests + trading_day_requests + klines_requests + other_requests;
+  }
+
+  void on_connect(mock::Socket& socket) override;
+  void on_data(mock::Socket& socket) override;
+
+  /// Body of the klines response to @p path, oldest candle first.
+  std::string klines(const std::string& path);
+
+ private:
+  std::string respond(const std::string& path, int* status);
+  std::string batch(const std::string& path, const char* field,
+                    const std::map<std::string, std::string>& values);
+
+  std::map<std::string, std::string> prices_;
+  std::map<std::string, std::string> opens_;
+  uint32_t                           responses_ = 0;
+};
+
+/// RFC 1123 date ("Thu, 16 Oct 2025 00:00:00 GMT") for @p epoch.
+std::string http_date(uint32_t epoch);
@@ -0,0 +1,152 @@
+/**
+ * @file mock_stream.cpp
+ * @brief RFC 6455 server side of the replayed miniTicker stream.
+ */
+
+#include "mock_stream.h"
+
+#include <fstream>
+
+#include "mock_host.h"
+
+#define WS_OP_CONTINUATION 0x0
+#define WS_OP_TEXT         0x1
+#define WS_OP_CLOSE        0x8
+#define WS_OP_PING         0x9
+#define WS_OP_PONG         0xA
+
+MockStream::MockStream() {
+  mock::network_serve("stream.binance.com", 9443, *this);
+  connect_ms   = 40;
+  handshake_ms = 450;
+  resume_ms    = 130;
+  tls          = true;
+}
+
+bool MockStream::load(const char* path) {
+  mock::HostScope host;
+  std::ifstream   in(path);
+  for (std::string line; std::getline(in, line);) {
+    if (!line.empty()) messages_.push_back(line);
+  }
+  return !messages_.empty();
+}
+
+void MockStream::on_connect(mock::Socket& socket) {
+  socket_   = &socket;
+  upgraded_ = false;
+}
+
+void MockStream::on_close(mock::Socket& socket) {
+  if (socket_ == &socket) socket_ = nullptr;
+}
+
+void MockStream::hang_up() {
+  if (socket_ == nullptr) return;
+  socket_->send(frame(WS_OP_CLOSE, true, std::string("\x03\xe9", 2)));
+  socket_->close();
+}
+
+/// Server frames are never masked.
+std::string MockStream::frame(uint8_t opcode, bool fin, const std::string& payload) {
+  std::string out;
+  out += (char)((fin ? 0x80 : 0x00) | opcode);
+  if (payload.size() < 126) {
+    out += (char)payload.size();
+  } else if (payload.size() < 65536) {
+    out += (char)126;
+    out += (char)(payload.size() >> 8);
+    out += (char)(payload.size() & 0xFF);
+  } else {
+    out += (char)127;
+    for (int shift = 56; shift >= 0; shift -= 8) out += (char)((uint64_t)payload.size() >> shift);
+  }
+  return out + payload;
+}
+
+void MockStream::on_data(mock::Socket& socket) {
+  std::string& inbox = socket.inbox();
+
+  if (!upgraded_) {
+    size_t end = inbox.find("\r\n\r\n");
+    if (end == std::string::npos) return;
+    request_line = inbox.substr(0, inbox.find("\r\n"));
+    bool websocket = inbox.find("Upgrade: websocket") < end
+                  && inbox.find("Sec-WebSocket-Version: 13") < end;
+    inbox.erase(0, end + 4);
+    if (!websocket) {
+      socket.send("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+      socket.close();
+      return;
+    }
+    upgraded_ = true;
+    connections++;
+    std::string response = "HTTP/1.1 101 Switching Protocols\r\n"
+                           "Upgrade: websocket\r\n"
+                           "Connection: Upgrade\r\n"
+                           "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n"
+                           "\r\n";
+    size_t status = response.find("\r\n") + 2;
+    socket.send(response.substr(0, status), connect_ms);
+    socket.send(response.substr(status), connect_ms + upgrade_stall_ms);
+    replay(socket);
+    return;
+  }
+
+  // Client frames: only masked PONGs are expected
+  while (inbox.size() >= 2) {
+    uint8_t len = inbox[1] & 0x7F;
+    bool masked = inbox[1] & 0x80;
+    if (len >= 126 || inbox.size() < (size_t)(2 + (masked ? 4 : 0) + len)) return;
+    std::string payload = inbox.substr(2 + (masked ? 4 : 0), len);
+    for (size_t i = 0; masked && i < payload.size(); i++) payload[i] ^= inbox[2 + i % 4];
+    if (masked && (inbox[0] & 0x0F) == WS_OP_PONG && payload == "p" + std::to_string(pongs)) {
+      pongs++;
+    } else {
+      bad_frames++;
+    }
+    inbox.erase(0, 2 + (masked ? 4 : 0) + len);
+  }
+}
+
+/// Queue the messages not sent yet, then CLOSE if close_after ends this connection.
+void MockStream::replay(mock::Socket& socket) {
+  uint32_t on_this = 0;
+  uint32_t at_ms   = connect_ms;
+  auto     deliver = [&](const std::string& bytes) {
+    if (piece_bytes == 0) {
+      socket.send(bytes, at_ms);
+      return;
+    }
+    for (size_t i = 0; i < bytes.size(); i += piece_bytes) {
+      socket.send(bytes.substr(i, piece_bytes), at_ms);
+      at_ms++;
+    }
+  };
+
+  while (sent < messages_.size()) {
+    if (close_after != 0 && on_this == close_after) {
+      deliver(frame(WS_OP_CLOSE, true, std::string("\x03\xe8", 2)));
+      socket.close(at_ms);
+      return;
+    }
+    const std::string& message = messages_[sent];
+    at_ms += interval_ms;
+    if (fragment) {
+      size_t half = message.size() / 2;
+      deliver(frame(WS_OP_TEXT, false, message.substr(0, half)));
+      if (ping_every != 0 && (sent + 1) % ping_every == 0) {
+        // Control frames may arrive between the fragments of a message
+        deliver(frame(WS_OP_PING, true, "p" + std::to_string(pings++)));
+      }
+      deliver(frame(WS_OP_CONTINUATION, true, message.substr(half)));
+    } else {
+      deliver(frame(WS_OP_TEXT, true, message));
+      if (ping_every != 0 && (sent + 1) % ping_every == 0) {
+        deliver(frame(WS_OP_PING, true, "p" + std::to_string(pings++)));
+      }
+    }
+    sent++;
+    on_this++;
+  }
+}
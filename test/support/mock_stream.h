@@ -0,0 +1,59 @@
+/**
+ * @file mock_stream.h
+ * @brief Local stand-in for the Binance WebSocket stream, replaying recorded frames.
+ *
+ * Accepts the HTTP Upgrade on stream.binance.com:9443, then sends the
+ * loaded miniTicker messages as server frames, one every interval_ms.  The
+ * options cover what the device's frame decoder has to survive: messages
+ * fragmented into continuation frames, pings between messages, frames
+ * trickled in small pieces, the server closing the stream, and an upgrade
+ * response that stops after its status line.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "mock_network.h"
+
+class MockStream : public mock::Service {
+ public:
+  MockStream();
+
+  /// Load one message per line from @p path; false if it cannot be read.
+  bool load(const char* path);
+
+  const std::vector<std::string>& messages() const { return messages_; }
+
+  uint32_t interval_ms      = 2;       ///< between consecutive messages
+  bool     fragment         = false;   ///< send each message as TEXT + CONTINUATION
+  uint32_t ping_every       = 0;       ///< a PING after every Nth message
+  uint32_t piece_bytes      = 0;       ///< deliver frames in pieces of this size, 1 ms apart
+  uint32_t close_after      = 0;       ///< send CLOSE after this many messages per connection
+  uint32_t upgrade_stall_ms = 0;       ///< the 101's headers arrive this long after its status
+
+  // ── Counters ──
+  uint32_t connections = 0;        ///< successful upgrades
+  uint32_t sent        = 0;        ///< messages sent, over all connections
+  uint32_t pings       = 0;
+  uint32_t pongs       = 0;        ///< well-formed masked PONGs echoing the ping payload
+  uint32_t bad_frames  = 0;        ///< client frames that were unmasked or unexpected
+  std::string request_line;        ///< of the last upgrade
+
+  /// Close the open stream now, with a CLOSE frame, as Binance does every 24 h.
+  void hang_up();
+
+  void on_connect(mock::Socket& socket) override;
+  void on_data(mock::Socket& socket) override;
+  void on_close(mock::Socket& socket) override;
+
+ private:
+  void        replay(mock::Socket& socket);
+  std::string frame(uint8_t opcode, bool fin, const std::string& payload);
+
+  std::vector<std::string> messages_;
+  mock::Socket*            socket_   = nullptr;
+  bool                     upgraded_ = false;
+};
@@ -0,0 +1,90 @@
+/**
+ * @file sim.cpp
+ * @brief Virtual-time driver for setup() and loop().
+ */
+
+#include "sim.h"
+
+#include <Arduino.h>
+
+#include <stdlib.h>
+
+#include "metrics.h"
+#include "mock_host.h"
+#include "sketch.h"
+
+namespace sim {
+
+void boot() {
+  mock::clock_reset();
+  mock::serial_clear();
+  mock::wire_clear();
+  mock::heap_reset_peak();
+  mock::DeviceScope device;
+  setup();
+}
+
+static uint64_t longest_loop = 0;
+
+static void step() {
+  uint64_t start = mock::now_us();
+  {
+    mock::DeviceScope device;
+    loop();
+  }
+  if (mock::now_us() - start > longest_loop) longest_loop = mock::now_us() - start;
+  mock::advance_ms(1);
+}
+
+void run_ms(uint32_t ms) {
+  uint64_t end = mock::now_us() + (uint64_t)ms * 1000;
+  while (mock::now_us() < end) step();
+}
+
+bool run_until(const std::function<bool()>& done, uint32_t max_ms) {
+  uint64_t end = mock::now_us() + (uint64_t)max_ms * 1000;
+  while (!done()) {
+    if (mock::now_us() >= end) return false;
+    step();
+  }
+  return true;
+}
+
+uint64_t longest_loop_us() {
+  return longest_loop;
+}
+
+void reset_longest_loop() {
+  longest_loop = 0;
+}
+
+namespace {
+
+class TextPrint : public Print {
+ public:
+  size_t write(uint8_t c) override {
+    text += (char)c;
+    return 1;
+  }
+  std::string text;
+};
+
+}  // namespace
+
+std::string metrics_text() {
+  mock::HostScope host;
+  TextPrint       out;
+  metrics_write(out);
+  return out.text;
+}
+
+double metric(const char* series) {
+  std::string text = metrics_text();
+  std::string key  = std::string(series) + " ";
+  size_t      at   = (text.compare(0, key.size(), key) == 0) ? 0 : text.find("\n" + key);
+  if (at == std::string::npos) return -1;
+  if (at != 0) at++;
+  return atof(text.c_str() + at + key.size());
+}
+
+}  // namespace sim
@@ -0,0 +1,39 @@
+/**
+ * @file sim.h
+ * @brief Runs the sketch on the virtual clock.
+ *
+ * loop() is called back to back, with the clock moved on by 1 ms between
+ * calls (plus whatever the call itself spent in yield(), delay() and I2C
+ * transfers), so a simulated minute takes well under a second.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+
+namespace sim {
+
+/// Restart the clock and clear Serial, the I2C log and the heap peak; then run setup().
+void boot();
+
+/// Call loop() until @p ms of virtual time have passed.
+void run_ms(uint32_t ms);
+
+/// Call loop() until @p done() holds or @p max_ms have passed; true if it held.
+bool run_until(const std::function<bool()>& done, uint32_t max_ms);
+
+/// Longest single loop() call since the last reset, in virtual µs: how long
+/// the sketch kept every other task waiting.
+uint64_t longest_loop_us();
+void     reset_longest_loop();
+
+/// Everything metrics_write() prints (the "stats" command and /metrics).
+std::string metrics_text();
+
+/// Value of the sample line starting with @p series, e.g.
+/// "tracker_phase_duration_seconds_count{phase=\"parse\"}"; -1 if absent.
+double metric(const char* series);
+
+}  // namespace sim
@@ -0,0 +1,50 @@
+/**
+ * @file sketch.h
+ * @brief The sketch's globals, as the host tests see them.
+ *
+ * They are defined in bitcoin-tracker-oled.ino, which has no header of its
+ * own; the declarations here must stay in step with it.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "candle_chart.h"
+#include "config.h"
+#include "price.h"
+#include "tick_history.h"
+#include "utc_clock.h"
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+  #include "display_lcd.h"
+#else
+  #include "display_oled.h"
+#endif
+
+enum Fetch { FETCH_NONE, FETCH_OPENS, FETCH_PRICES, FETCH_AGGREGATE, FETCH_CHART };
+
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LCD
+extern LcdDisplay  screen;
+#else
+extern OledDisplay screen;
+#endif
+
+extern price_t     current_prices[];
+extern price_t     closing_prices[];
+extern TickHistory price_history[];
+extern UtcClock    utc_clock;
+extern DayRollover opens_day;
+extern int         symbol_index;
+extern int         shown_index;
+extern price_t     shown_price;
+extern bool        wifi_up;
+extern bool        have_opens;
+extern bool        have_prices;
+extern bool        screen_dirty;
+extern bool        prices_stale;
+extern Fetch       fetching;
+extern CandleChart chart;
+extern int         chart_index;
+extern bool        showing_chart;
+
+void setup();
+void loop();
@@ -0,0 +1,10 @@
+/**
+ * @file sketch_main.cpp
+ * @brief Compiles the sketch's .ino as a C++ translation unit.
+ *
+ * The Arduino build prepends <Arduino.h> to the .ino; this does the same.
+ */
+
+#include <Arduino.h>
+
+#include "bitcoin-tracker-oled.ino"
@@ -0,0 +1,82 @@
+/**
+ * @file test_connect.cpp
+ * @brief Connection setup: handshake timeout and fallback hosts.
+ *
+ * A TLS handshake slower than the old 2 s connect timeout must still
+ * succeed, since BearSSL bounds the TCP connect and the handshake with one
+ * timeout.  A primary host that accepts no connection must be given up on
+ * after the 2 s TCP probe, not the 5 s handshake timeout, and the next
+ * fallback host used; the same goes for a cached address that stops
+ * answering.  Reconnects reuse the cached address and send the host name
+ * for SNI; lwIP answers their lookups from its table until the record's
+ * TTL runs out.
+ */
+
+#include <string>
+
+#include "check.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "sim.h"
+#include "sketch.h"
+
+static bool contains(const char* text) {
+  return mock::serial_output().find(text) != std::string::npos;
+}
+
+int main() {
+  // Nothing answers on the primary host; api1 is slow to handshake but healthy
+  MockBinance dead;
+  MockBinance binance;
+  dead.reachable       = false;
+  binance.handshake_ms = 3000;
+  mock::network_serve("api.binance.com", 443, dead);
+
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 30000));
+  printf("connect: %u failures, %u handshakes, first prices at %llu ms\n",
+         mock::net_stats().failures, mock::net_stats().tls_handshakes,
+         (unsigned long long)(mock::now_us() / 1000));
+
+  CHECK(contains("[conn] connect to api.binance.com failed after 2000 ms"));
+  CHECK(!contains("api1.binance.com failed"));
+  CHECK_EQ(mock::net_stats().failures, 1);
+  CHECK_EQ(mock::net_stats().tls_handshakes, 1);
+  CHECK_EQ(dead.requests(), 0);
+  CHECK_GE(binance.requests(), 2);
+
+  // The server closes after every response for 30 s: each reconnect probes
+  // the cached address and looks the name up for the TLS connect, and none
+  // of those lookups goes to the network within the 60 s TTL
+  mock::NetStats before      = mock::net_stats();
+  uint32_t       connections = binance.connections;
+  binance.close_every        = 1;
+  binance.handshake_ms       = 450;
+  sim::run_ms(30000);
+  uint32_t reconnects = binance.connections - connections;
+  printf("reconnects: %u, lookups %u, queries %u\n", reconnects,
+         mock::net_stats().dns_lookups - before.dns_lookups,
+         mock::net_stats().dns_queries - before.dns_queries);
+  CHECK_GE(reconnects, 10);
+  CHECK_GE(mock::net_stats().dns_lookups - before.dns_lookups, reconnects);
+  CHECK_EQ(mock::net_stats().dns_queries - before.dns_queries, 0);
+  CHECK_EQ(mock::net_stats().failures, 1);
+
+  // Every address stops answering while api1's is still cached: the probe
+  // gives up on it in 2 s, and requests resume once the hosts answer again
+  mock::serial_clear();
+  before            = mock::net_stats();
+  binance.reachable = false;
+  sim::run_ms(8000);
+  printf("dead address: %u failures in 8 s\n", mock::net_stats().failures - before.failures);
+  CHECK(contains("[conn] connect to api1.binance.com failed after 2000 ms"));
+  CHECK(!contains("failed after 5000 ms"));
+  CHECK_GE(mock::net_stats().failures - before.failures, 1);
+  CHECK_EQ(mock::net_stats().tls_handshakes, before.tls_handshakes);
+
+  binance.reachable = true;
+  uint32_t served   = binance.requests();
+  CHECK(sim::run_until([&] { return binance.requests() > served; }, 15000));
+
+  return check_failures();
+}
@@ -0,0 +1,67 @@
+/**
+ * @file test_keepalive.cpp
+ * @brief The REST connection is opened once and reused across polls.
+ *
+ * Counts TLS connections at the mock server: a minute of polling must run
+ * over a single handshake.  When the server closes the socket after a
+ * response, the next connection resumes the TLS session, and no poll
+ * fails on the way.
+ */
+
+#include <string>
+
+#include "check.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "sim.h"
+#include "sketch.h"
+
+static int count(const std::string& text, const char* what) {
+  int n = 0;
+  for (size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1)) n++;
+  return n;
+}
+
+int main() {
+  MockBinance binance;
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 10000));
+
+  // Keep the visible price moving so polling stays at the full rate
+  auto poll_for = [&](uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += 1000) {
+      binance.set_price("BTCUSDT", std::to_string(60000 + t / 1000) + ".00000000");
+      binance.set_price("ETHUSDT", std::to_string(2400 + t / 1000) + ".00000000");
+      sim::run_ms(1000);
+    }
+  };
+
+  // A minute of polls, one connection
+  poll_for(60000);
+  printf("keep-alive: %u requests, %u connections, %u handshakes, %u resumptions\n",
+         binance.requests(), binance.connections, mock::net_stats().tls_handshakes,
+         mock::net_stats().tls_resumptions);
+  CHECK_GE(binance.ticker_requests, 30);
+  CHECK_EQ(binance.connections, 1);
+  CHECK_EQ(mock::net_stats().tls_handshakes, 1);
+  CHECK_EQ(mock::net_stats().dns_queries, 1);
+
+  // Server closes after every 4th response: reconnects resume the session
+  uint32_t requests    = binance.requests();
+  uint32_t connections = binance.connections;
+  binance.close_every  = 4;
+  poll_for(60000);
+  uint32_t served      = binance.requests() - requests;
+  uint32_t reconnects  = binance.connections - connections;
+  printf("close every 4: %u requests, %u reconnects, %u resumptions\n", served, reconnects,
+         mock::net_stats().tls_resumptions);
+  CHECK_GE(served, 30);
+  CHECK_LE(reconnects, (served + 3) / 4);
+  CHECK_GE(reconnects, served / 4);
+  CHECK_EQ(mock::net_stats().tls_handshakes, 1);
+  CHECK_EQ(mock::net_stats().tls_resumptions, reconnects);
+  CHECK_EQ(count(mock::serial_output(), "[api]"), 0);
+  CHECK_EQ(count(mock::serial_output(), "[conn]"), 0);
+
+  return check_failures();
+}
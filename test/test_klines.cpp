@@ -0,0 +1,131 @@
+/**
+ * @file test_klines.cpp
+ * @brief Candle chart fetch: flat memory whatever the limit, and pixel accuracy.
+ *
+ * Fetches the BTC chart through request_klines() / poll_klines() with the
+ * scripted API answering 64, 128 and 1000 candles, on a price that trends
+ * up, then down, through the response, so the chart's range is grown and
+ * shrunk (and every stored candle remapped) while parsing.  Each fetch must:
+ *  - keep the newest CHART_CANDLES candles;
+ *  - reach the same heap and stack peaks, however long the response;
+ *  - place every open, high, low and close within 1 px of where the
+ *    double-precision prices, scaled over their own range, would put them.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "api.h"
+#include "candle_chart.h"
+#include "check.h"
+#include "config.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "sim.h"
+#include "sketch.h"
+
+// Candle area of the chart screen, as render_chart() lays it out: level 0 on
+// the bottom row, CANDLE_LEVELS on the top one, this many pixels apart
+#define CHART_PIXELS (OLED_HEIGHT - 10 - 1)
+
+struct Fetched {
+  int    candles;
+  size_t heap_peak;
+  size_t stack_peak;
+};
+
+/// One chart fetch, driven directly while the sketch is idle.
+static Fetched fetch_chart(CandleChart& chart) {
+  mock::heap_reset_peak();
+  mock::stack_paint();
+  int result = -1;
+  {
+    mock::DeviceScope device;
+    if (request_klines("BTC")) {
+      uint32_t waited = 0;
+      while ((result = poll_klines(chart)) == API_PENDING && waited++ < 60000) {
+        mock::advance_ms(1);
+      }
+    }
+  }
+  return {result, mock::heap().peak, mock::stack_peak()};
+}
+
+/// open, high, low, close of every candle in a klines body.
+static std::vector<double> parse_ohlc(const std::string& body) {
+  std::vector<double> ohlc;
+  for (size_t at = body.find("[", 1); at != std::string::npos; at = body.find("[", at + 1)) {
+    const char* p = body.c_str() + body.find(',', at) + 1;
+    for (int field = 0; field < 4; field++) {
+      ohlc.push_back(strtod(p + 1, nullptr));             // past the opening quote
+      p = strchr(p + 1, ',') + 1;
+    }
+  }
+  return ohlc;
+}
+
+/// Largest distance in pixels between the packed candles and @p ohlc (the newest ones).
+static double worst_pixel_error(const CandleChart& chart, const std::vector<double>& ohlc) {
+  size_t first = ohlc.size() - 4 * chart.size();
+  double lo = ohlc[first + 2], hi = ohlc[first + 1];
+  for (size_t i = first; i < ohlc.size(); i += 4) {
+    lo = fmin(lo, ohlc[i + 2]);
+    hi = fmax(hi, ohlc[i + 1]);
+  }
+
+  double worst = 0;
+  for (uint8_t i = 0; i < chart.size(); i++) {
+    const CandleChart::Candle& c         = chart.candle(i);
+    const uint8_t              levels[4] = {c.open, c.high, c.low, c.close};
+    for (int field = 0; field < 4; field++) {
+      double exact  = (ohlc[first + 4 * i + field] - lo) / (hi - lo) * CHART_PIXELS;
+      double packed = (double)levels[field] * CHART_PIXELS / CANDLE_LEVELS;
+      worst         = fmax(worst, fabs(exact - packed));
+    }
+  }
+  return worst;
+}
+
+int main() {
+  MockBinance binance;
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 10000));
+  CHECK(sim::run_until([] { return chart_index >= 0 && fetching == FETCH_NONE; }, 10000));
+
+  static CandleChart chart;
+  const double       drifts[] = {0.0004, -0.0004};
+  const uint32_t     limits[] = {64, 128, 1000};
+  Fetched            first    = {};
+
+  for (double drift : drifts) {
+    binance.klines_drift = drift;
+    for (uint32_t limit : limits) {
+      binance.klines_limit = limit;
+      Fetched fetched      = fetch_chart(chart);
+      if (first.candles == 0) first = fetched;
+
+      std::vector<double> ohlc =
+          parse_ohlc(binance.klines("/api/v3/klines?symbol=BTCUSDT&limit=1"));
+      double error = worst_pixel_error(chart, ohlc);
+      printf("drift %+.4f, limit=%-4u: %d candles, %.1f-%.1f, heap peak %zu, "
+             "stack peak %zu, worst error %.3f px\n", drift, limit, fetched.candles,
+             (double)chart.lowest() / PRICE_SCALE, (double)chart.highest() / PRICE_SCALE,
+             fetched.heap_peak, fetched.stack_peak, error);
+
+      CHECK_EQ(fetched.candles, CHART_CANDLES);
+      CHECK_EQ(ohlc.size(), 4 * limit);
+      CHECK(error <= 1.0);
+
+      // Memory is the same whatever the response length
+      CHECK_GE(fetched.stack_peak, 1);
+      CHECK_EQ(fetched.heap_peak, first.heap_peak);
+      CHECK_EQ(fetched.stack_peak, first.stack_peak);
+    }
+  }
+
+  return check_failures();
+}
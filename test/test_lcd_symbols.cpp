@@ -0,0 +1,49 @@
+/**
+ * @file test_lcd_symbols.cpp
+ * @brief LCD rows for symbols of every length the watchlist accepts.
+ *
+ * A symbol of up to SYMBOL_MAX_LENGTH characters must appear in full on
+ * both the price and the chart screen.  Where the row is short of room the
+ * "/$" suffix goes first and then the cents, never part of the symbol.
+ */
+
+#include "check.h"
+#include "config.h"
+#include "display_lcd.h"
+#include "mock_host.h"
+#include "price.h"
+#include "watchlist.h"
+
+#define CENTS(c) ((price_t)(c) * (PRICE_SCALE / 100))
+
+static LcdDisplay lcd;
+
+static std::string show(const char* symbol, price_t price) {
+  PriceView view = {price, price - CENTS(100), PRICE_UNITS(60000), symbol, false, nullptr};
+  lcd.show(view);
+  printf("|%s|  %s\n", mock::lcd_row(0).c_str(), symbol);
+  return mock::lcd_row(0);
+}
+
+int main() {
+  lcd.begin();
+
+  CHECK_STR(show("BTC", CENTS(6095001)).c_str(), "^ 60950.01 BTC/$");
+  CHECK_STR(show("DOGE", CENTS(6095001)).c_str(), "^ 60950.01  DOGE");
+  CHECK_STR(show("DOGE", CENTS(16)).c_str(), "^ 0.16    DOGE/$");
+  CHECK_STR(show("ABCDEFG", CENTS(6095001)).c_str(), "^ 60950  ABCDEFG");
+  CHECK_STR(show("ABCDEFG", CENTS(16)).c_str(), "^ 0.16 ABCDEFG/$");
+
+  CandleChart candles;
+  for (int i = 0; i < CHART_CANDLES; i++) {
+    candles.add(PRICE_UNITS(60000), PRICE_UNITS(61000), PRICE_UNITS(59000), PRICE_UNITS(60500));
+  }
+  candles.finish();
+  ChartView chart = {&candles, "ABCDEFG"};
+  lcd.chart(chart);
+  printf("|%s|\n", mock::lcd_row(0).c_str());
+  CHECK_EQ(mock::lcd_row(0).compare(0, SYMBOL_MAX_LENGTH + 1, "ABCDEFG "), 0);
+  CHECK_EQ(mock::lcd_row(0).back(), '^');
+
+  return check_failures();
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_partial_flush.cpp
+ * @brief I2C bytes of a price tick: partial refresh against a full-frame flush.
+ *
+ * Draws the price screen into a panel on the mocked bus and flushes it with
+ * display_flush().  After a forced full flush, one-cent ticks must send
+ * only the changed windows: far fewer bytes, counted identically by
+ * display_last_flush_bytes() and the bus, with the SH1106's RAM afterwards
+ * showing exactly the composed frame.
+ */
+
+#include <Wire.h>
+
+#include "check.h"
+#include "config.h"
+#include "display_utils.h"
+#include "mock_host.h"
+#include "price.h"
+
+/// Bytes that crossed the bus since the last wire_clear(), control bytes included.
+static uint64_t bus_bytes() {
+  uint64_t n = mock::wire_bytes();
+  mock::wire_clear();
+  return n;
+}
+
+static uint64_t flush(Adafruit_SH1106G& panel, price_t current, price_t previous, price_t open) {
+  compose_screen(panel, current, previous, open, "BTC");
+  bus_bytes();
+  display_flush(panel);
+  uint64_t sent = bus_bytes();
+  CHECK_EQ(sent, display_last_flush_bytes());
+  CHECK(mock::sh1106_shows(panel.getBuffer()));
+  return sent;
+}
+
+int main() {
+  Wire.begin(OLED_SDA, OLED_SCL);
+  Adafruit_SH1106G panel(OLED_WIDTH, OLED_HEIGHT, &Wire, OLED_RESET, OLED_I2C_CLOCK,
+                         OLED_I2C_CLOCK);
+  CHECK(panel.begin(OLED_I2C_ADDR, true));
+  panel.setTextColor(SH110X_WHITE);
+
+  const price_t open = price_parse("59754.91");
+  display_invalidate();
+  uint64_t full = flush(panel, price_parse("60950.01"), price_parse("60950.01"), open);
+
+  // One digit changes: prices this size are shown in whole dollars, and the
+  // % change stays at +2.00 %
+  uint64_t one_digit = flush(panel, price_parse("60951.01"), price_parse("60950.01"), open);
+
+  // A run of typical ticks, some moving the % change as well
+  static const char* const TICKS[] = {
+    "60952.07", "60949.98", "60951.30", "60962.00", "60955.55", "61012.40", "60998.10",
+  };
+  uint64_t ticks = 0;
+  price_t  last  = price_parse("60951.01");
+  for (const char* tick : TICKS) {
+    ticks += flush(panel, price_parse(tick), last, open);
+    last   = price_parse(tick);
+  }
+  uint64_t tick_mean = ticks / (sizeof(TICKS) / sizeof(TICKS[0]));
+
+  // Nothing changed: nothing is sent
+  uint64_t unchanged = flush(panel, last, last, open);
+
+  printf("full frame %llu B, one digit %llu B, typical tick %llu B, unchanged %llu B\n",
+         (unsigned long long)full, (unsigned long long)one_digit,
+         (unsigned long long)tick_mean, (unsigned long long)unchanged);
+
+  // A full flush is the whole 1 KB plus addressing and control bytes
+  CHECK_GE(full, OLED_WIDTH * OLED_HEIGHT / 8);
+  CHECK_GE(one_digit, 1);
+  CHECK_LE(one_digit * 10, full);
+  CHECK_LE(tick_mean * 3, full);
+  CHECK_EQ(unchanged, 0);
+
+  return check_failures();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_price.cpp
+ * @brief Parsing quotes, and drawing them exactly as the double-based sketch did.
+ *
+ * Anything that is not a plain non-negative decimal whose integer part fits
+ * in price_t must come back as -1 rather than as some other price.
+ *
+ * The price screen's text and layout (price_layout()) must match what the
+ * retired draw_price() printed from a double (legacy_price.h) in every
+ * magnitude band: a table of edge cases, then a sweep of random 8-decimal
+ * quotes per band.  Exact ties at the 5th decimal are left out of the
+ * comparison: the double path rounded whichever way the binary
+ * approximation fell, where price_format() rounds them up.
+ */
+
+#include <stdint.h>
+
+#include <string>
+
+#include "check.h"
+#include "display_utils.h"
+#include "legacy_price.h"
+#include "price.h"
+
+/// What the price screen draws for @p quote, in the legacy_price() form.
+static LegacyPrice fixed_price(const char* quote) {
+  char        text[PRICE_TEXT_SIZE];
+  PriceLayout at = price_layout(price_parse(quote), text);
+  return {at.x, std::string(text, at.large), at.small ? at.small_x : (int16_t)0,
+          std::string(text + at.large, at.small)};
+}
+
+static int mismatches = 0;
+
+static void compare(const char* quote) {
+  LegacyPrice want = legacy_price(quote);
+  LegacyPrice got  = fixed_price(quote);
+  if (got.x == want.x && got.large == want.large && got.small_x == want.small_x &&
+      got.small == want.small) {
+    return;
+  }
+  if (mismatches++ < 10) {
+    printf("%s: double [%d \"%s\" %d \"%s\"], fixed [%d \"%s\" %d \"%s\"]\n", quote,
+           want.x, want.large.c_str(), want.small_x, want.small.c_str(), got.x,
+           got.large.c_str(), got.small_x, got.small.c_str());
+  }
+}
+
+// Band edges and the roundings that carry into the next digit or band
+static const char* const EDGE_QUOTES[] = {
+  "0.00000000", "0.00000001", "0.00004999", "0.12345678", "1.00000000", "9.99994999",
+  "9.99996000", "10.00000000", "10.12345678", "99.99960000", "99.99999999", "100.00000000",
+  "999.12345678", "999.99990000", "1000.00000000", "1000.01000000", "60950.01000000",
+  "99999.99999999", "100000.00000000", "123456.78900000", "999999.99999999",
+  "1000000.00000000", "1234567.89000000", "9999999.99999999",
+};
+
+struct Band {
+  uint64_t low;       ///< whole dollars, inclusive
+  uint64_t high;      ///< whole dollars, exclusive
+};
+
+static const Band BANDS[] = {
+  {0, 10}, {10, 1000}, {1000, 100000}, {100000, 1000000}, {1000000, 10000000},
+};
+
+int main() {
+  CHECK_EQ(price_parse("60950.01000000"), PRICE_UNITS(60950) + PRICE_SCALE / 100);
+  CHECK_EQ(price_parse("0.00000001"), 1);
+  CHECK_EQ(price_parse("0.123456789"), 12345678);     // 9th digit truncated
+  CHECK_EQ(price_parse("42"), PRICE_UNITS(42));
+  CHECK_EQ(price_parse("42."), PRICE_UNITS(42));
+
+  CHECK_EQ(price_parse(nullptr), -1);
+  CHECK_EQ(price_parse(""), -1);
+  CHECK_EQ(price_parse(".5"), -1);
+  CHECK_EQ(price_parse("-1.0"), -1);
+  CHECK_EQ(price_parse("1.0x"), -1);
+  CHECK_EQ(price_parse("1,5"), -1);
+
+  // The integer part must leave room for eight fractional digits in int64_t
+  CHECK_EQ(price_parse("92233720367.99999999"), 9223372036799999999LL);
+  CHECK_EQ(price_parse("92233720368"), -1);
+  CHECK_EQ(price_parse("9223372036854775807"), -1);
+  CHECK_EQ(price_parse("99999999999999999999999999.5"), -1);
+
+  // Ties round up, the same at every magnitude
+  char text[PRICE_TEXT_SIZE];
+  price_format(text, price_parse("0.00005"), 4);
+  CHECK_STR(text, "0.0001");
+  price_format(text, price_parse("1.00005"), 4);
+  CHECK_STR(text, "1.0001");
+  price_format(text, price_parse("60950.00005"), 4);
+  CHECK_STR(text, "60950.0001");
+
+  // Same text, same places as the double path
+  for (const char* quote : EDGE_QUOTES) compare(quote);
+
+  uint64_t seed     = 0x2545F4914F6CDD1DULL;
+  int      compared = 0;
+  for (const Band& band : BANDS) {
+    for (int i = 0; i < 20000; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      uint64_t whole = band.low + (seed >> 33) % (band.high - band.low);
+      uint32_t frac  = (uint32_t)(seed % 100000000);
+      if (frac % 10000 == 5000) continue;               // exact tie, see above
+      char quote[32];
+      snprintf(quote, sizeof(quote), "%llu.%08u", (unsigned long long)whole, frac);
+      compare(quote);
+      compared++;
+    }
+  }
+  printf("layout: %d quotes compared, %d differ from the double path\n",
+         compared + (int)(sizeof(EDGE_QUOTES) / sizeof(EDGE_QUOTES[0])), mismatches);
+  CHECK_EQ(mismatches, 0);
+
+  return check_failures();
+}
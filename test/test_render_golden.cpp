@@ -0,0 +1,191 @@
+/**
+ * @file test_render_golden.cpp
+ * @brief Reference frames of the price screen against committed PBM goldens.
+ *
+ * The price layout in display_utils.cpp has many hand-placed ranges and
+ * thresholds.  This renders a fixed set of cases — every price range of
+ * draw_price(), both @c DIFF_PRINT_PERCENTAGE_AND_VALUE layouts, both sides
+ * of every icon threshold, the no-decimal change and the cached tag — into
+ * an off-screen 128×64 canvas with render_screen(), and compares each frame
+ * pixel for pixel with test/golden/render_case_NN.pbm.
+ *
+ * One line per case gives its inputs, the average render time in µs on this
+ * machine and how many pixels differ.  A frame that differs is also written
+ * as render_case_NN.pbm next to the test binary, to view beside the golden
+ * one.  After an intended layout change, review those images, then rewrite
+ * the goldens with:
+ *
+ *   test_render_golden --update
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "check.h"
+#include "display_utils.h"
+#include "price.h"
+
+// Renders per case for the timing; the first one also warms the caches.
+#define RENDER_REPEAT 20
+
+/// One reference frame.  Prices in whole cents, so the table stays readable.
+struct RenderCase {
+  int64_t current_cents;
+  int64_t open_cents;
+  bool    show_value;
+  bool    stale;
+};
+
+#define CENTS(c) ((price_t)(c) * (PRICE_SCALE / 100))
+
+// Price ranges of draw_price() at about +2 %, then the icon thresholds on a
+// $1000 open, where +1 % is exactly $10, then the cached tag.
+static const RenderCase cases[] = {
+  // ≥ $1 M, ≥ $100 K, ≥ $1 K, ≥ $10, < $10 (four decimals)
+  { 123456789,  121036067, false, false },
+  { 123456789,  121036067, true,  false },
+  { 12345678,   12103606,  false, false },
+  { 12345678,   12103606,  true,  false },
+  { 6095001,    5975491,   false, false },
+  { 6095001,    5975491,   true,  false },
+  { 4212,       4129,      false, false },
+  { 4212,       4129,      true,  false },
+  { 57,         56,        false, false },
+  { 57,         56,        true,  false },
+  // Either side of +3.5 %, +1.5 %, 0 %, −1.5 %, −3.5 %
+  { 103500,     100000,    false, false },
+  { 103499,     100000,    false, false },
+  { 101500,     100000,    false, false },
+  { 101499,     100000,    false, false },
+  { 100000,     100000,    false, false },
+  { 99999,      100000,    false, false },
+  { 98501,      100000,    false, false },
+  { 98500,      100000,    false, false },
+  { 96501,      100000,    false, false },
+  { 96500,      100000,    true,  false },
+  // ±10 % and beyond: no decimal digit in the large layout
+  { 112000,     100000,    false, false },
+  { 88000,      100000,    false, false },
+  // Boot snapshot tag
+  { 6095001,    5975491,   false, true  },
+};
+
+static const int CASE_COUNT = sizeof(cases) / sizeof(cases[0]);
+
+static void draw_case(GFXcanvas1& canvas, const RenderCase& c) {
+  canvas.fillScreen(0);
+  render_screen(canvas, CENTS(c.current_cents), CENTS(c.current_cents),
+                CENTS(c.open_cents), "BTC", c.stale, c.show_value);
+}
+
+static const char* mode(const RenderCase& c) {
+  return c.stale ? "stale" : (c.show_value ? "value" : "pct");
+}
+
+static std::string golden_path(int index) {
+  char name[32];
+  snprintf(name, sizeof(name), "render_case_%02d.pbm", index);
+  return std::string(TEST_SOURCE_DIR "/golden/") + name;
+}
+
+/// The canvas as an ASCII PBM: "P1", @p comment, size, then one row of 0/1 per line.
+static std::string to_pbm(const GFXcanvas1& canvas, const std::string& comment) {
+  std::ostringstream out;
+  out << "P1\n# " << comment << "\n" << OLED_WIDTH << " " << OLED_HEIGHT << "\n";
+  for (int16_t y = 0; y < OLED_HEIGHT; y++) {
+    for (int16_t x = 0; x < OLED_WIDTH; x++) out << (canvas.getPixel(x, y) ? '1' : '0');
+    out << "\n";
+  }
+  return out.str();
+}
+
+/// Pixels of an ASCII PBM, one '0' or '1' each, row by row; empty if it is not a
+/// 128×64 P1 image.
+static std::string pbm_pixels(const std::string& pbm) {
+  std::string text;
+  for (size_t at = 0; at < pbm.size();) {
+    size_t end = pbm.find('\n', at);
+    if (end == std::string::npos) end = pbm.size();
+    if (pbm[at] != '#') text += pbm.substr(at, end - at) + " ";
+    at = end + 1;
+  }
+
+  std::istringstream in(text);
+  std::string        magic;
+  int                width = 0, height = 0;
+  in >> magic >> width >> height;
+  if (magic != "P1" || width != OLED_WIDTH || height != OLED_HEIGHT) return "";
+
+  std::string pixels;
+  for (char c; in >> c;) {
+    if (c == '0' || c == '1') pixels += c;
+  }
+  return (pixels.size() == (size_t)width * height) ? pixels : "";
+}
+
+static std::string read_file(const std::string& path) {
+  std::ifstream      in(path);
+  std::ostringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+int main(int argc, char** argv) {
+  bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+
+  GFXcanvas1 canvas(OLED_WIDTH, OLED_HEIGHT);
+  canvas.setTextColor(1);
+
+  printf("# case      current         open  mode       us  frame\n");
+  for (int i = 0; i < CASE_COUNT; i++) {
+    const RenderCase& c = cases[i];
+
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < RENDER_REPEAT; n++) draw_case(canvas, c);
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now()
+                                                          - start).count() / RENDER_REPEAT;
+
+    char current[PRICE_TEXT_SIZE];
+    char open[PRICE_TEXT_SIZE];
+    char comment[64];
+    price_format(current, CENTS(c.current_cents), 2);
+    price_format(open, CENTS(c.open_cents), 2);
+    printf("%6d %12s %12s  %-5s %7.1f  ", i, current, open, mode(c), us);
+
+    snprintf(comment, sizeof(comment), "render case %d: %s on open %s, %s", i, current, open,
+             mode(c));
+    std::string frame = to_pbm(canvas, comment);
+
+    if (update) {
+      std::ofstream(golden_path(i)) << frame;
+      printf("written\n");
+      continue;
+    }
+
+    std::string want = pbm_pixels(read_file(golden_path(i)));
+    std::string got  = pbm_pixels(frame);
+    if (want.empty()) {
+      printf("no golden frame\n");
+      check_failure_count()++;
+      continue;
+    }
+    int differ = 0;
+    for (size_t p = 0; p < got.size(); p++) differ += (got[p] != want[p]);
+    if (differ == 0) {
+      printf("ok\n");
+      continue;
+    }
+    printf("%d px differ\n", differ);
+    check_failure_count()++;
+
+    char name[32];
+    snprintf(name, sizeof(name), "render_case_%02d.pbm", i);
+    std::ofstream(name) << frame;
+  }
+  return update ? 0 : check_failures();
+}
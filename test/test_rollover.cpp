@@ -0,0 +1,96 @@
+/**
+ * @file test_rollover.cpp
+ * @brief UTC clock and daily-open rollover, on an injected clock.
+ *
+ * The unit part drives UtcClock and DayRollover with explicit millis()
+ * values, including a millis() wrap.  The integration part boots the
+ * tracker at 23:59:30 UTC (the mock API's Date header) and runs it across
+ * midnight: the daily opens must be refetched exactly once, and the new
+ * ones shown.
+ */
+
+#include "check.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "price.h"
+#include "sim.h"
+#include "sketch.h"
+#include "utc_clock.h"
+
+#define OCT_16_2025 1760572800UL   // 2025-10-16 00:00:00 UTC
+
+static void check_date_parsing() {
+  uint32_t epoch = 0;
+  CHECK(http_date_parse(" Thu, 16 Oct 2025 23:59:58 GMT", &epoch));
+  CHECK_EQ(epoch, OCT_16_2025 + UTC_SECONDS_PER_DAY - 2);
+  CHECK(http_date_parse("Sat, 29 Feb 2028 00:00:00 GMT", &epoch));
+  CHECK_EQ(epoch, 1835395200UL);
+  CHECK(!http_date_parse("Thu, 16 Oct 2025 23:59 GMT", &epoch));
+  CHECK(!http_date_parse("Thursday, 16-Oct-25 23:59:58 GMT", &epoch));
+
+  // Every second of a day round-trips through the mock server's formatter
+  bool all = true;
+  for (uint32_t t = OCT_16_2025; t < OCT_16_2025 + UTC_SECONDS_PER_DAY; t += 7) {
+    all = all && http_date_parse(http_date(t).c_str(), &epoch) && epoch == t;
+  }
+  CHECK(all);
+}
+
+static void check_clock() {
+  UtcClock    clock;
+  DayRollover rollover;
+  CHECK(!clock.valid());
+  CHECK(!rollover.due(clock, 0));
+
+  // Synced 2 s before midnight; millis() wraps 1 s later
+  unsigned long synced = 0xFFFFFFFFUL - 999;
+  clock.sync(OCT_16_2025 + UTC_SECONDS_PER_DAY - 2, synced);
+  rollover.mark(clock, synced);
+  CHECK_EQ(clock.now(synced + 1999), OCT_16_2025 + UTC_SECONDS_PER_DAY - 1);
+  CHECK(!rollover.due(clock, synced + 1999));
+  CHECK_EQ(clock.now(synced + 2000), OCT_16_2025 + UTC_SECONDS_PER_DAY);
+  CHECK(rollover.due(clock, synced + 2000));
+  CHECK_EQ(clock.day(synced + 2000), OCT_16_2025 / UTC_SECONDS_PER_DAY + 1);
+
+  rollover.mark(clock, synced + 2500);
+  CHECK(!rollover.due(clock, synced + 2500));
+  CHECK(!rollover.due(clock, synced + 2000 + 86399999UL));
+  CHECK(rollover.due(clock, synced + 2000 + 86400000UL));
+
+  // Opens restored from flash for an earlier day are due at once
+  DayRollover restored;
+  restored.mark_day(OCT_16_2025 / UTC_SECONDS_PER_DAY);
+  CHECK(restored.due(clock, synced + 2000));
+}
+
+static void check_midnight() {
+  MockBinance binance;
+  binance.epoch_at_boot = OCT_16_2025 + UTC_SECONDS_PER_DAY - 30;
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 10000));
+  CHECK_EQ(binance.trading_day_requests, 1);
+  CHECK_EQ(closing_prices[0], price_parse("60000.00"));
+
+  // Binance moves the opens at 00:00 UTC
+  binance.set_open("BTCUSDT", "61234.50000000");
+  binance.set_open("ETHUSDT", "2444.40000000");
+  sim::run_ms(20000);
+  CHECK_EQ(binance.trading_day_requests, 1);
+
+  sim::run_ms(120000);
+  printf("midnight: %u tradingDay requests, %u price polls\n", binance.trading_day_requests,
+         binance.ticker_requests);
+  CHECK_EQ(binance.trading_day_requests, 2);
+  CHECK_EQ(closing_prices[0], price_parse("61234.50"));
+  CHECK_EQ(closing_prices[1], price_parse("2444.40"));
+  CHECK(have_opens);
+  CHECK(!opens_day.due(utc_clock, millis()));
+  CHECK_EQ(utc_clock.day(millis()), OCT_16_2025 / UTC_SECONDS_PER_DAY + 1);
+}
+
+int main() {
+  check_date_parsing();
+  check_clock();
+  check_midnight();
+  return check_failures();
+}
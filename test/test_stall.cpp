@@ -0,0 +1,120 @@
+/**
+ * @file test_stall.cpp
+ * @brief A stalled upstream never holds up rotation, rendering or animation.
+ *
+ * For half a minute every API response is held back 4 s while the prices
+ * keep moving; for the next half minute each response stops 4 s after its
+ * status line, in the middle of the headers; for the last one the headers
+ * and half of each body arrive at once and the rest 4 s later, chunked.
+ * Either way the scheduler must carry on as if the network were fast: the
+ * screen rotates on time, no loop() pass blocks for longer than an
+ * animation frame, and no frame of the price tick transitions is dropped.
+ * Headers that stop arriving altogether are cut off after 5 s, a body
+ * after CONN_BODY_TIMEOUT_MS, and the polls after them go through.
+ */
+
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "config.h"
+#include "connection.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "sim.h"
+#include "sketch.h"
+
+#define STALL_MS           4000
+#define ROTATION_JITTER_MS 5
+
+static double frames(const char* counter) {
+  return sim::metric((std::string("tracker_anim_") + counter + "_total").c_str());
+}
+
+/// Watch the screen for 30 s, moving both prices every 700 ms, and check its pacing.
+static void watch(MockBinance& binance, const char* phase) {
+  sim::reset_longest_loop();
+  double drawn   = frames("frames_drawn");
+  double dropped = frames("frames_dropped");
+
+  std::vector<uint64_t> switches;
+  int      last_index = symbol_index;
+  bool     last_chart = showing_chart;
+  uint32_t answered   = binance.ticker_requests;
+  for (int ms = 0; ms < 30000; ms++) {
+    if (ms % 700 == 0) {
+      binance.set_price("BTCUSDT", std::to_string(60000 + ms / 700) + ".10000000");
+      binance.set_price("ETHUSDT", std::to_string(2400 + ms / 700) + ".10000000");
+    }
+    sim::run_ms(1);
+    if (symbol_index != last_index || showing_chart != last_chart) {
+      switches.push_back(mock::now_us() / 1000);
+      last_index = symbol_index;
+      last_chart = showing_chart;
+    }
+  }
+
+  printf("%s: %zu screen switches, %u polls, longest loop %llu us, "
+         "frames %g drawn %g dropped\n", phase, switches.size(),
+         binance.ticker_requests - answered, (unsigned long long)sim::longest_loop_us(),
+         frames("frames_drawn") - drawn, frames("frames_dropped") - dropped);
+
+  // Rotation keeps its period exactly
+  CHECK_GE(switches.size(), 2);
+  const uint64_t period = SECONDS_TO_DISPLAY_EACH_SYMBOL * 1000;
+  for (size_t i = 1; i < switches.size(); i++) {
+    CHECK_GE(switches[i] - switches[i - 1], period - ROTATION_JITTER_MS);
+    CHECK_LE(switches[i] - switches[i - 1], period + ROTATION_JITTER_MS);
+  }
+
+  // Polls did go through the stall, and ticks were animated meanwhile
+  CHECK_GE(binance.ticker_requests - answered, 3);
+  CHECK_GE(frames("frames_drawn") - drawn, ANIM_ROLL_MS * ANIM_FPS / 1000);
+  CHECK_EQ(frames("frames_dropped") - dropped, 0);
+  CHECK_LE(sim::longest_loop_us(), 1000000 / ANIM_FPS);
+  CHECK_EQ(have_prices, true);
+}
+
+int main() {
+  MockBinance binance;
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 10000));
+  sim::run_ms(5000);
+
+  // Nothing arrives for 4 s after each request
+  binance.stall_ms    = STALL_MS;
+  binance.stall_count = 1000;
+  watch(binance, "stall");
+  binance.stall_count = 0;
+
+  // Each response stops after its status line for 4 s
+  binance.header_stall_ms = STALL_MS;
+  watch(binance, "header stall");
+
+  // Headers that stop for longer than the header timeout are given up on
+  mock::serial_clear();
+  binance.header_stall_ms = 10000;
+  CHECK(sim::run_until([] {
+    return mock::serial_output().find("[conn] response headers timed out") != std::string::npos;
+  }, 15000));
+  binance.header_stall_ms = 0;
+  binance.set_price("BTCUSDT", "60500.00000000");
+  CHECK(sim::run_until([] { return current_prices[0] == PRICE_UNITS(60500); }, 15000));
+
+  // Each body stops halfway for 4 s
+  binance.body_stall_ms = STALL_MS;
+  binance.chunked       = true;
+  watch(binance, "body stall");
+
+  // A body that stops for longer than the body timeout is given up on
+  mock::serial_clear();
+  binance.body_stall_ms = CONN_BODY_TIMEOUT_MS + 5000;
+  CHECK(sim::run_until([] {
+    return mock::serial_output().find("[conn] response body timed out") != std::string::npos;
+  }, CONN_BODY_TIMEOUT_MS + 5000));
+  binance.body_stall_ms = 0;
+  binance.set_price("BTCUSDT", "61000.00000000");
+  CHECK(sim::run_until([] { return current_prices[0] == PRICE_UNITS(61000); }, 5000));
+
+  return check_failures();
+}
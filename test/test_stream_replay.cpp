@@ -0,0 +1,122 @@
+/**
+ * @file test_stream_replay.cpp
+ * @brief Streaming mode against recorded miniTicker frames, replayed at high rate.
+ *
+ * fixtures/miniticker_frames.jsonl holds 240 combined-stream messages for
+ * BTC and ETH (and one for a symbol not on the watchlist), replayed 2 ms
+ * apart instead of Binance's one per second per symbol.  After each replay
+ * the prices and rolling opens on the device must be the last ones sent:
+ *  1. whole frames, with no heap allocation once the stream is open;
+ *  2. fragmented messages with pings in between, trickled 5 bytes at a
+ *     time, and the server closing the stream every 100 messages;
+ *  3. an upgrade response that stops for 2 s after its status line, which
+ *     no loop() pass may wait on;
+ *  4. all messages at once with the server's CLOSE right behind them, read
+ *     in the same poll as the last ones: their prices must still be
+ *     published, so the tick history ends on them too.
+ */
+
+#include <string>
+
+#include "check.h"
+#include "mock_binance.h"
+#include "mock_host.h"
+#include "mock_stream.h"
+#include "price.h"
+#include "sim.h"
+#include "sketch.h"
+
+/// Value of "key":"..." in @p message.
+static std::string field(const std::string& message, const char* key) {
+  std::string quoted = std::string("\"") + key + "\":\"";
+  size_t      at     = message.find(quoted) + quoted.size();
+  return message.substr(at, message.find('"', at) - at);
+}
+
+/// The device shows the last close and open recorded for each symbol.
+static void check_last_values(const MockStream& stream) {
+  for (int i = 0; i < size_of_list_of_symbols; i++) {
+    std::string pair = std::string(list_of_symbols[i]) + "USDT";
+    std::string close, open;
+    for (const std::string& message : stream.messages()) {
+      if (field(message, "s") != pair) continue;
+      close = field(message, "c");
+      open  = field(message, "o");
+    }
+    CHECK_EQ(current_prices[i], price_parse(close.c_str()));
+    CHECK_EQ(closing_prices[i], price_parse(open.c_str()));
+    CHECK(price_history[i].is_newest(current_prices[i]));
+  }
+}
+
+int main() {
+  MockBinance binance;
+  MockStream  stream;
+  CHECK(stream.load(TEST_SOURCE_DIR "/fixtures/miniticker_frames.jsonl"));
+
+  sim::boot();
+  CHECK(sim::run_until([&] { return stream.connections == 1; }, 10000));
+  CHECK_STR(stream.request_line,
+            "GET /stream?streams=btcusdt@miniTicker/ethusdt@miniTicker HTTP/1.1");
+
+  // 1. Whole frames: the decoder runs without touching the heap
+  uint64_t allocations = mock::heap().allocations;
+  CHECK(sim::run_until([&] { return stream.sent == stream.messages().size(); }, 5000));
+  sim::run_ms(3000);
+  printf("replay: %u messages, %llu allocations\n", stream.sent,
+         (unsigned long long)(mock::heap().allocations - allocations));
+  CHECK_EQ(mock::heap().allocations - allocations, 0);
+  check_last_values(stream);
+
+  // 2. Fragments, pings and 5-byte pieces, closed every 100 messages
+  stream.sent        = 0;
+  stream.fragment    = true;
+  stream.ping_every  = 7;
+  stream.piece_bytes = 5;
+  stream.close_after = 100;
+  stream.hang_up();
+  CHECK(sim::run_until([&] { return stream.sent == stream.messages().size(); }, 60000));
+  sim::run_ms(15000);
+  printf("replay: %u connections, %u pings, %u pongs, %u bad frames\n", stream.connections,
+         stream.pings, stream.pongs, stream.bad_frames);
+  CHECK_EQ(stream.connections, 4);
+  CHECK_GE(stream.pings, 30);
+  CHECK_EQ(stream.pongs, stream.pings);
+  CHECK_EQ(stream.bad_frames, 0);
+  check_last_values(stream);
+
+  // 3. The upgrade stalls mid-response: the longest loop() pass is the TLS
+  //    connect, not the wait for the 101's headers
+  stream.sent             = 0;
+  stream.fragment         = false;
+  stream.ping_every       = 0;
+  stream.piece_bytes      = 0;
+  stream.close_after      = 0;
+  stream.upgrade_stall_ms = 2000;
+  stream.hang_up();
+  sim::reset_longest_loop();
+  CHECK(sim::run_until([&] { return stream.sent == stream.messages().size(); }, 10000));
+  sim::run_ms(10000);
+  printf("upgrade stall: longest loop %llu us\n", (unsigned long long)sim::longest_loop_us());
+  CHECK_EQ(stream.connections, 5);
+  CHECK_LE(sim::longest_loop_us(), (stream.connect_ms + stream.handshake_ms + 50) * 1000ULL);
+  check_last_values(stream);
+
+  // 4. Every message at once, then CLOSE: the last poll reads both
+  stream.sent             = 0;
+  stream.interval_ms      = 0;
+  stream.upgrade_stall_ms = 0;
+  stream.hang_up();
+  CHECK(sim::run_until([&] { return stream.connections == 6; }, 10000));
+  stream.hang_up();
+  sim::run_ms(10000);
+  printf("close behind data: %u messages\n", stream.sent);
+  CHECK_EQ(stream.sent, stream.messages().size());
+  check_last_values(stream);
+
+  // Prices came from the stream only: the opens once at boot, no REST polls
+  CHECK_EQ(binance.ticker_requests, 0);
+  CHECK_EQ(binance.trading_day_requests, 1);
+
+  return check_failures();
+}
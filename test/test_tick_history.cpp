@@ -0,0 +1,40 @@
+/**
+ * @file test_tick_history.cpp
+ * @brief Only price changes are recorded in the tick history.
+ *
+ * Polls that return the same prices must leave every symbol's history as
+ * it was; a tick on one symbol adds one sample to that symbol only.
+ */
+
+#include "check.h"
+#include "mock_binance.h"
+#include "sim.h"
+#include "sketch.h"
+
+int main() {
+  MockBinance binance;
+  sim::boot();
+  CHECK(sim::run_until([] { return have_opens && have_prices; }, 10000));
+  uint16_t btc = price_history[0].size();
+  uint16_t eth = price_history[1].size();
+  CHECK_EQ(btc, 1);
+  CHECK_EQ(eth, 1);
+
+  // Twenty seconds of unchanged prices
+  uint32_t polls = binance.ticker_requests;
+  sim::run_ms(20000);
+  printf("polls: %u, history: BTC %u, ETH %u\n", binance.ticker_requests - polls,
+         price_history[0].size(), price_history[1].size());
+  CHECK_GE(binance.ticker_requests - polls, 5);
+  CHECK_EQ(price_history[0].size(), btc);
+  CHECK_EQ(price_history[1].size(), eth);
+
+  // One tick on BTC
+  binance.set_price("BTCUSDT", "60951.01000000");
+  sim::run_ms(5000);
+  CHECK_EQ(price_history[0].size(), btc + 1);
+  CHECK_EQ(price_history[1].size(), eth);
+  CHECK_EQ(price_history[0].highest(), PRICE_UNITS(60951) + PRICE_SCALE / 100);
+
+  return check_failures();
+}